@@ -171,6 +171,9 @@ void bl1_main(void)
 	PMF_CAPTURE_TIMESTAMP(bl_svc, BL1_EXIT, PMF_CACHE_MAINT);
 #endif
 
+	/* Report or hand over the boot phase timings */
+	bootmarker_dump();
+
 	console_flush();
 }
 
@@ -52,4 +52,12 @@ endif
 
 ifeq (${ENABLE_PMF},1)
 BL2_SOURCES		+=	lib/pmf/pmf_main.c
-endif
\ No newline at end of file
+endif
+
+ifeq (${ENABLE_BOOT_PHASE_MARKERS},1)
+BL2_SOURCES		+=	lib/pmf/pmf_boot_phase.c
+endif
+
+ifeq (${ENABLE_CONSOLE_RING},1)
+BL2_SOURCES		+=	drivers/console/console_ring.c
+endif
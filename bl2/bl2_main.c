@@ -15,6 +15,7 @@
 #include <drivers/auth/auth_mod.h>
 #include <drivers/auth/crypto_mod.h>
 #include <drivers/console.h>
+#include <drivers/console_ring.h>
 #include <drivers/fwu/fwu.h>
 #include <lib/bootmarker_capture.h>
 #include <lib/extensions/pauth.h>
@@ -47,6 +48,9 @@ void bl2_el3_setup(u_register_t arg0, u_register_t arg1, u_register_t arg2,
 	/* Perform late platform-specific setup */
 	bl2_el3_plat_arch_setup();
 
+	/* Start buffering the console output once the rings are mapped */
+	console_ring_init();
+
 #if CTX_INCLUDE_PAUTH_REGS
 	/*
 	 * Assert that the ARMv8.3-PAuth registers are present or an access
@@ -69,6 +73,9 @@ void bl2_setup(u_register_t arg0, u_register_t arg1, u_register_t arg2,
 	/* Perform late platform-specific setup */
 	bl2_plat_arch_setup();
 
+	/* Start buffering the console output once the rings are mapped */
+	console_ring_init();
+
 #if CTX_INCLUDE_PAUTH_REGS
 	/*
 	 * Assert that the ARMv8.3-PAuth registers are present or an access
@@ -119,6 +126,9 @@ void bl2_main(void)
 	/* Teardown the Measured Boot backend */
 	bl2_plat_mboot_finish();
 
+	/* Report or hand over the boot phase timings */
+	bootmarker_dump();
+
 #if !BL2_RUNS_AT_EL3
 #ifndef __aarch64__
 	/*
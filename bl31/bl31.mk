@@ -56,6 +56,26 @@ ifeq (${ENABLE_PMF}, 1)
 BL31_SOURCES		+=	lib/pmf/pmf_main.c
 endif
 
+ifeq (${PSCI_STAT_SNAPSHOT},1)
+BL31_SOURCES		+=	lib/psci/psci_stat_smc.c
+endif
+
+ifeq (${ENABLE_LOG_LEVEL_SMC},1)
+BL31_SOURCES		+=	common/tf_log_smc.c
+endif
+
+ifeq (${ENABLE_PMF_TRACE},1)
+BL31_SOURCES		+=	lib/pmf/pmf_trace.c
+endif
+
+ifeq (${ENABLE_CONSOLE_RING},1)
+BL31_SOURCES		+=	drivers/console/console_ring.c
+endif
+
+ifeq (${ENABLE_BOOT_PHASE_MARKERS},1)
+BL31_SOURCES		+=	lib/pmf/pmf_boot_phase.c
+endif
+
 include lib/debugfs/debugfs.mk
 ifeq (${USE_DEBUGFS},1)
 	BL31_SOURCES	+= $(DEBUGFS_SRCS)
@@ -65,6 +85,13 @@ ifeq (${EL3_EXCEPTION_HANDLING},1)
 BL31_SOURCES		+=	bl31/ehf.c
 endif
 
+ifeq (${EHF_STATS},1)
+ifeq (${EL3_EXCEPTION_HANDLING},0)
+  $(error EL3_EXCEPTION_HANDLING must be 1 for EHF_STATS)
+endif
+BL31_SOURCES		+=	bl31/ehf_stats.c
+endif
+
 ifeq (${FFH_SUPPORT},1)
 BL31_SOURCES		+=	bl31/aarch64/ea_delegate.S
 endif
@@ -80,6 +107,16 @@ BL31_SOURCES		+=	services/std_svc/sdei/sdei_dispatch.S	\
 				services/std_svc/sdei/sdei_state.c
 endif
 
+ifeq (${RAS_CE_BATCHING},1)
+ifeq (${SDEI_SUPPORT},0)
+  $(error SDEI_SUPPORT must be 1 for RAS_CE_BATCHING)
+endif
+ifneq (${PLAT_RAS_POLL_TIMER},1)
+  $(error RAS_CE_BATCHING requires a platform poll timer (PLAT_RAS_POLL_TIMER=1))
+endif
+BL31_SOURCES		+=	lib/extensions/ras/ras_batch.c
+endif
+
 ifeq (${TRNG_SUPPORT},1)
 BL31_SOURCES		+=	services/std_svc/trng/trng_main.c	\
 				services/std_svc/trng/trng_entropy_pool.c
@@ -174,13 +211,18 @@ endif
 $(eval $(call assert_booleans,\
     $(sort \
 	CRASH_REPORTING \
+	EHF_STATS \
 	EL3_EXCEPTION_HANDLING \
+	PLAT_RAS_POLL_TIMER \
+	RAS_CE_BATCHING \
 	SDEI_SUPPORT \
 )))
 
 $(eval $(call add_defines,\
     $(sort \
         CRASH_REPORTING \
+        EHF_STATS \
         EL3_EXCEPTION_HANDLING \
+        RAS_CE_BATCHING \
         SDEI_SUPPORT \
 )))
@@ -17,16 +17,18 @@
 #include <common/feat_detect.h>
 #include <common/runtime_svc.h>
 #include <drivers/console.h>
+#include <drivers/console_ring.h>
 #include <lib/bootmarker_capture.h>
 #include <lib/el3_runtime/context_mgmt.h>
 #include <lib/pmf/pmf.h>
+#include <lib/psci/psci_lib.h>
 #include <lib/runtime_instr.h>
 #include <plat/common/platform.h>
 #include <services/std_svc.h>
 
 #if ENABLE_RUNTIME_INSTRUMENTATION
 	PMF_REGISTER_SERVICE_SMC(rt_instr_svc, PMF_RT_INSTR_SVC_ID,
-		RT_INSTR_TOTAL_IDS, PMF_STORE_ENABLE)
+		RT_INSTR_TOTAL_IDS, PMF_STORE_ENABLE | PMF_TRACE_ENABLE)
 #endif
 
 #if ENABLE_RUNTIME_INSTRUMENTATION
@@ -99,6 +101,9 @@ void bl31_setup(u_register_t arg0, u_register_t arg1, u_register_t arg2,
 	/* Perform late platform-specific setup */
 	bl31_plat_arch_setup();
 
+	/* Start buffering the console output once the rings are mapped */
+	console_ring_init();
+
 #if CTX_INCLUDE_PAUTH_REGS
 	/*
 	 * Assert that the ARMv8.3-PAuth registers are present or an access
@@ -143,7 +148,9 @@ void bl31_main(void)
 #endif
 
 	/* Perform platform setup in BL31 */
+	BOOT_PHASE_START(BOOT_PHASE_PLAT_SETUP, BOOT_PHASE_NO_IMAGE);
 	bl31_platform_setup();
+	BOOT_PHASE_END(BOOT_PHASE_PLAT_SETUP, BOOT_PHASE_NO_IMAGE);
 
 	/* Initialise helper libraries */
 	bl31_lib_init();
@@ -157,6 +164,15 @@ void bl31_main(void)
 	INFO("BL31: Initializing runtime services\n");
 	runtime_svc_init();
 
+#if PSCI_EARLY_CPU_INIT
+	/*
+	 * Let the secondary cpus perform their per-cpu initialisation in
+	 * parallel and park until they are turned on.
+	 */
+	INFO("BL31: Initializing secondary CPUs\n");
+	psci_early_cpu_init();
+#endif
+
 	/*
 	 * All the cold boot actions on the primary cpu are done. We now need to
 	 * decide which is the next image and how to execute it.
@@ -219,6 +235,11 @@ void bl31_main(void)
 	PMF_CAPTURE_TIMESTAMP(bl_svc, BL31_EXIT, PMF_CACHE_MAINT);
 	console_flush();
 #endif
+
+#if ENABLE_BOOT_PHASE_MARKERS
+	bootmarker_dump();
+	console_flush();
+#endif
 }
 
 /*******************************************************************************
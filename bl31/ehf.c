@@ -12,6 +12,7 @@
 #include <stdbool.h>
 
 #include <bl31/ehf.h>
+#include <bl31/ehf_stats.h>
 #include <bl31/interrupt_mgmt.h>
 #include <context.h>
 #include <common/debug.h>
@@ -19,6 +20,7 @@
 #include <lib/el3_runtime/context_mgmt.h>
 #include <lib/el3_runtime/cpu_data.h>
 #include <lib/el3_runtime/pubsub_events.h>
+#include <lib/pmf/pmf.h>
 #include <plat/common/platform.h>
 
 /* Output EHF logs as verbose */
@@ -150,6 +152,8 @@ void ehf_activate_priority(unsigned int priority)
 	if (cur_pri_idx == EHF_INVALID_IDX)
 		pe_data->init_pri_mask = (uint8_t) old_mask;
 
+	ehf_stats_activate(idx);
+
 	EHF_LOG("activate prio=%d\n", get_pe_highest_active_idx(pe_data));
 }
 
@@ -198,6 +202,8 @@ void ehf_deactivate_priority(unsigned int priority)
 	/* Clear bit corresponding to highest priority */
 	pe_data->active_pri_bits &= (pe_data->active_pri_bits - 1u);
 
+	ehf_stats_deactivate(idx);
+
 	/*
 	 * Restore priority mask corresponding to the next priority, or the
 	 * one stashed earlier if there are no more to deactivate.
@@ -254,6 +260,8 @@ static void *ehf_exited_normal_world(const void *arg)
 		panic();
 	}
 
+	ehf_stats_ns_blocked();
+
 	EHF_LOG("Priority Mask: 0x%x => 0x%x\n", pe_data->ns_pri_mask,
 			GIC_HIGHEST_NS_PRIORITY);
 
@@ -305,6 +313,8 @@ static void *ehf_entering_normal_world(const void *arg)
 		panic();
 	}
 
+	ehf_stats_ns_unblocked();
+
 	EHF_LOG("Priority Mask: 0x%x => 0x%x\n", old_pmr, pe_data->ns_pri_mask);
 
 	pe_data->ns_pri_mask = 0;
@@ -353,6 +363,8 @@ void ehf_allow_ns_preemption(uint64_t preempt_ret_code)
 
 	old_pmr = plat_ic_set_priority_mask(pe_data->ns_pri_mask);
 
+	ehf_stats_ns_unblocked();
+
 	EHF_LOG("Priority Mask: 0x%x => 0x%x\n", old_pmr, pe_data->ns_pri_mask);
 
 	pe_data->ns_pri_mask = 0;
@@ -397,6 +409,7 @@ static uint64_t ehf_el3_interrupt_handler(uint32_t id, uint32_t flags,
 	uint32_t intr_raw;
 	unsigned int intr, pri, idx;
 	ehf_handler_t handler;
+	uint64_t start __unused;
 
 	/*
 	 * Top-level interrupt type handler from Interrupt Management Framework
@@ -417,6 +430,10 @@ static uint64_t ehf_el3_interrupt_handler(uint32_t id, uint32_t flags,
 	if (intr == INTR_ID_UNAVAILABLE)
 		return 0;
 
+	start = ehf_stats_begin();
+
+	PMF_TRACE_EVENT(PMF_TRACE_EL3_INTR, intr);
+
 	/* Having acknowledged the interrupt, get the running priority */
 	pri = plat_ic_get_running_priority();
 
@@ -445,6 +462,7 @@ static uint64_t ehf_el3_interrupt_handler(uint32_t id, uint32_t flags,
 	 * handlers.
 	 */
 	ret = handler(intr_raw, flags, handle, cookie);
+	ehf_stats_end(idx, start);
 
 	return (uint64_t) ret;
 }
@@ -475,6 +493,8 @@ void __init ehf_init(void)
 	assert((exception_data.pri_bits >= 1U) ||
 			(exception_data.pri_bits < 8U));
 
+	ehf_stats_init();
+
 	/* Route EL3 interrupts when in Non-secure. */
 	set_interrupt_rm_flag(flags, NON_SECURE);
 
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Statistics of the time spent by EL3 at each exception handling priority
+ * level, and of the time Non-secure interrupts were masked by Secure execution.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+
+#include <platform_def.h>
+
+#include <arch_helpers.h>
+#include <bl31/ehf.h>
+#include <bl31/ehf_stats.h>
+#include <common/debug.h>
+#include <common/runtime_svc.h>
+#include <lib/pmf/pmf.h>
+#include <lib/utils.h>
+#include <lib/utils_def.h>
+#include <plat/common/platform.h>
+#include <smccc_helpers.h>
+
+/* Number of priority levels with statistics, at most the EHF limit of 32 */
+#ifndef PLAT_EHF_STATS_MAX_PRIORITIES
+#define PLAT_EHF_STATS_MAX_PRIORITIES	(sizeof(ehf_pri_bits_t) * 8U)
+#endif
+
+/* Index of the Non-secure masking windows in the statistics of a CPU */
+#define EHF_STATS_NS_BLOCKED_IDX	PLAT_EHF_STATS_MAX_PRIORITIES
+
+typedef struct ehf_stats_entry {
+	uint64_t count;
+	uint64_t total;
+	uint64_t max;
+} ehf_stats_entry_t;
+
+/*
+ * Statistics of a CPU, only written by this CPU. 'gen' is the reset generation
+ * the statistics belong to: the CPU clears them before recording anything once
+ * a reset was requested.
+ */
+typedef struct ehf_cpu_stats {
+	ehf_stats_entry_t entries[PLAT_EHF_STATS_MAX_PRIORITIES + 1U];
+	uint64_t active_start[PLAT_EHF_STATS_MAX_PRIORITIES];
+	uint64_t ns_blocked_start;
+	unsigned int gen;
+} __aligned(CACHE_WRITEBACK_GRANULE) ehf_cpu_stats_t;
+
+static ehf_cpu_stats_t ehf_cpu_stats[PLATFORM_CORE_COUNT];
+
+/* Reset generation requested by the Normal world */
+static volatile unsigned int ehf_stats_gen;
+
+/* To be defined by the platform */
+extern const ehf_priorities_t exception_data;
+
+static ehf_cpu_stats_t *ehf_this_cpu_stats(void)
+{
+	ehf_cpu_stats_t *stats = &ehf_cpu_stats[plat_my_core_pos()];
+	unsigned int gen = ehf_stats_gen;
+
+	if (stats->gen != gen) {
+		zeromem(stats->entries, sizeof(stats->entries));
+		stats->gen = gen;
+	}
+
+	return stats;
+}
+
+static void ehf_stats_add(ehf_stats_entry_t *entry, unsigned int idx,
+			  uint64_t ticks)
+{
+	entry->count++;
+	entry->total += ticks;
+
+	if (ticks > entry->max) {
+		entry->max = ticks;
+		PMF_TRACE_EVENT(PMF_TRACE_EHF_MAX, idx);
+	}
+}
+
+void ehf_stats_init(void)
+{
+	assert(exception_data.num_priorities <= PLAT_EHF_STATS_MAX_PRIORITIES);
+}
+
+/* Return the start time of the handling of an interrupt */
+uint64_t ehf_stats_begin(void)
+{
+	return read_cntpct_el0();
+}
+
+/* Account for the handling of an interrupt at the given priority index */
+void ehf_stats_end(unsigned int idx, uint64_t start)
+{
+	ehf_cpu_stats_t *stats = ehf_this_cpu_stats();
+
+	if (idx < PLAT_EHF_STATS_MAX_PRIORITIES) {
+		ehf_stats_add(&stats->entries[idx], idx,
+			      read_cntpct_el0() - start);
+	}
+}
+
+/* Record the explicit activation of the given priority index */
+void ehf_stats_activate(unsigned int idx)
+{
+	if (idx < PLAT_EHF_STATS_MAX_PRIORITIES) {
+		ehf_this_cpu_stats()->active_start[idx] = read_cntpct_el0();
+	}
+}
+
+/* Account for the explicit activation of the given priority index */
+void ehf_stats_deactivate(unsigned int idx)
+{
+	ehf_cpu_stats_t *stats = ehf_this_cpu_stats();
+
+	if (idx < PLAT_EHF_STATS_MAX_PRIORITIES) {
+		ehf_stats_add(&stats->entries[idx], idx,
+			      read_cntpct_el0() - stats->active_start[idx]);
+	}
+}
+
+/* Record that Secure execution started masking Non-secure interrupts */
+void ehf_stats_ns_blocked(void)
+{
+	ehf_this_cpu_stats()->ns_blocked_start = read_cntpct_el0();
+}
+
+/* Account for a window during which Non-secure interrupts were masked */
+void ehf_stats_ns_unblocked(void)
+{
+	ehf_cpu_stats_t *stats = ehf_this_cpu_stats();
+
+	if (stats->ns_blocked_start == 0ULL) {
+		return;
+	}
+
+	ehf_stats_add(&stats->entries[EHF_STATS_NS_BLOCKED_IDX],
+		      EHF_STATS_NS_BLOCKED,
+		      read_cntpct_el0() - stats->ns_blocked_start);
+	stats->ns_blocked_start = 0ULL;
+}
+
+/*
+ * Return the index of the statistics of a priority level, or -1 if the
+ * priority level is not one of the platform.
+ */
+static int ehf_stats_idx(u_register_t pri)
+{
+	unsigned int idx;
+
+	if (pri == EHF_STATS_NS_BLOCKED) {
+		return (int)EHF_STATS_NS_BLOCKED_IDX;
+	}
+
+	/* Only Secure priorities are used by the EHF */
+	if (pri >= 0x80U) {
+		return -1;
+	}
+
+	idx = EHF_PRI_TO_IDX(pri, exception_data.pri_bits);
+	if ((idx >= exception_data.num_priorities) ||
+	    ((exception_data.ehf_priorities[idx].ehf_handler &
+	      EHF_PRI_VALID_) == 0U) ||
+	    (((idx << (7U - exception_data.pri_bits)) & 0x7fU) != pri)) {
+		return -1;
+	}
+
+	return (int)idx;
+}
+
+/*
+ * This function handles the SMC calls reading and resetting the statistics of
+ * the priority levels. The statistics of a CPU are read while it may update
+ * them, so the fields of an entry may be from two consecutive updates.
+ */
+uintptr_t ehf_stats_smc_handler(unsigned int smc_fid,
+				u_register_t x1,
+				u_register_t x2,
+				u_register_t x3,
+				u_register_t x4,
+				void *cookie,
+				void *handle,
+				u_register_t flags)
+{
+	const ehf_cpu_stats_t *stats;
+	const ehf_stats_entry_t *entry;
+	int cpu_idx, idx;
+
+	/* Allow calls from non-secure only */
+	if (is_caller_secure(flags)) {
+		SMC_RET1(handle, EHF_STATS_E_DENIED);
+	}
+
+	if ((smc_fid != EHF_STATS_SMC_32) && (smc_fid != EHF_STATS_SMC_64)) {
+		WARN("Unimplemented EHF_STATS Call: 0x%x\n", smc_fid);
+		SMC_RET1(handle, SMC_UNK);
+	}
+
+	/* Truncate parameters if 32b SMC convention call */
+	if (GET_SMC_CC(smc_fid) == SMC_32) {
+		x1 = (uint32_t)x1;
+		x2 = (uint32_t)x2;
+		x3 = (uint32_t)x3;
+	}
+
+	switch (x1) {
+	case EHF_STATS_SMC_GET:
+		cpu_idx = plat_core_pos_by_mpidr(x2);
+		idx = ehf_stats_idx(x3);
+		if ((cpu_idx < 0) || (idx < 0)) {
+			SMC_RET1(handle, EHF_STATS_E_INVALID_PARAMS);
+		}
+
+		stats = &ehf_cpu_stats[cpu_idx];
+		if (stats->gen != ehf_stats_gen) {
+			/* Reset, and not updated since */
+			SMC_RET4(handle, EHF_STATS_E_SUCCESS, 0, 0, 0);
+		}
+
+		entry = &stats->entries[idx];
+		SMC_RET4(handle, EHF_STATS_E_SUCCESS, entry->count,
+			 entry->total, entry->max);
+
+	case EHF_STATS_SMC_RESET:
+		ehf_stats_gen = ehf_stats_gen + 1U;
+		SMC_RET1(handle, EHF_STATS_E_SUCCESS);
+
+	default:
+		SMC_RET1(handle, EHF_STATS_E_INVALID_PARAMS);
+	}
+}
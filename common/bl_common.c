@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2022, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2023, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -15,6 +15,7 @@
 #include <common/debug.h>
 #include <drivers/auth/auth_mod.h>
 #include <drivers/io/io_storage.h>
+#include <lib/bootmarker_capture.h>
 #include <lib/utils.h>
 #include <lib/xlat_tables/xlat_tables_defs.h>
 #include <plat/common/platform.h>
@@ -82,16 +83,20 @@ static int load_image(unsigned int image_id, image_info_t *image_data)
 
 	image_base = image_data->image_base;
 
+	BOOT_PHASE_START(BOOT_PHASE_IMG_OPEN, image_id);
+
 	/* Obtain a reference to the image by querying the platform layer */
 	io_result = plat_get_image_source(image_id, &dev_handle, &image_spec);
 	if (io_result != 0) {
 		WARN("Failed to obtain reference to image id=%u (%i)\n",
 			image_id, io_result);
+		BOOT_PHASE_END(BOOT_PHASE_IMG_OPEN, image_id);
 		return io_result;
 	}
 
 	/* Attempt to access the image */
 	io_result = io_open(dev_handle, image_spec, &image_handle);
+	BOOT_PHASE_END(BOOT_PHASE_IMG_OPEN, image_id);
 	if (io_result != 0) {
 		WARN("Failed to access image id=%u (%i)\n",
 			image_id, io_result);
@@ -123,7 +128,9 @@ static int load_image(unsigned int image_id, image_info_t *image_data)
 
 	/* We have enough space so load the image now */
 	/* TODO: Consider whether to try to recover/retry a partially successful read */
+	BOOT_PHASE_START(BOOT_PHASE_IMG_READ, image_id);
 	io_result = io_read(image_handle, image_base, image_size, &bytes_read);
+	BOOT_PHASE_END(BOOT_PHASE_IMG_READ, image_id);
 	if ((io_result != 0) || (bytes_read < image_size)) {
 		WARN("Failed to load image id=%u (%i)\n", image_id, io_result);
 		goto exit;
@@ -229,7 +236,9 @@ int load_auth_image(unsigned int image_id, image_info_t *image_data)
 		 * authentication in case of Trusted-Boot flow) then measure
 		 * it (if MEASURED_BOOT flag is enabled).
 		 */
+		BOOT_PHASE_START(BOOT_PHASE_IMG_MEASURE, image_id);
 		err = plat_mboot_measure_image(image_id, image_data);
+		BOOT_PHASE_END(BOOT_PHASE_IMG_MEASURE, image_id);
 		if (err != 0) {
 			return err;
 		}
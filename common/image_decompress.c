@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2018-2023, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -11,6 +11,7 @@
 #include <common/bl_common.h>
 #include <common/debug.h>
 #include <common/image_decompress.h>
+#include <lib/bootmarker_capture.h>
 
 static uintptr_t decompressor_buf_base;
 static uint32_t decompressor_buf_size;
@@ -63,9 +64,11 @@ int image_decompress(struct image_info *info)
 	work_base = compressed_image_base + compressed_image_size;
 	work_size = decompressor_buf_size - compressed_image_size;
 
+	BOOT_PHASE_START(BOOT_PHASE_IMG_DECOMPRESS, BOOT_PHASE_NO_IMAGE);
 	ret = decompressor(&compressed_image_base, compressed_image_size,
 			   &image_base, info->image_max_size,
 			   work_base, work_size);
+	BOOT_PHASE_END(BOOT_PHASE_IMG_DECOMPRESS, BOOT_PHASE_NO_IMAGE);
 	if (ret) {
 		ERROR("Failed to decompress image (err=%d)\n", ret);
 		return ret;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2019, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2023, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -8,12 +8,106 @@
 #include <assert.h>
 #include <stdio.h>
 
+#include <platform_def.h>
+
+#include <arch_helpers.h>
 #include <common/debug.h>
+#include <lib/spinlock.h>
+#include <lib/utils_def.h>
 #include <plat/common/platform.h>
 
 /* Set the default maximum log level to the `LOG_LEVEL` build flag */
 static unsigned int max_log_level = LOG_LEVEL;
 
+#if TF_LOG_RATELIMIT_SUPPORTED
+/*
+ * Each rate limited call site may print PLAT_LOG_RATELIMIT_BURST messages in a
+ * row, and is then allowed one more message every PLAT_LOG_RATELIMIT_INTERVAL_MS
+ * divided by PLAT_LOG_RATELIMIT_BURST milliseconds.
+ */
+#ifndef PLAT_LOG_RATELIMIT_BURST
+#define PLAT_LOG_RATELIMIT_BURST	U(10)
+#endif
+
+#ifndef PLAT_LOG_RATELIMIT_INTERVAL_MS
+#define PLAT_LOG_RATELIMIT_INTERVAL_MS	U(5000)
+#endif
+
+CASSERT(PLAT_LOG_RATELIMIT_BURST > 0U, assert_log_ratelimit_burst_non_zero);
+#endif /* TF_LOG_RATELIMIT_SUPPORTED */
+
+#if TF_LOG_BIN_SUPPORTED
+/*
+ * Each CPU appends the binary log records to its own ring of 64-bit words. A
+ * record is made of:
+ *  - a header word holding TF_LOG_BIN_REC_MAGIC, the log level, the number of
+ *    arguments and the offset of the format string in the .tf_log_fmt section,
+ *  - the value of the physical counter when the message was logged,
+ *  - the arguments, each one in a word.
+ * Records wrap around the ring word by word. 'head' counts the words written
+ * since boot, so the oldest record is found by searching for a header word
+ * from 'head' modulo the number of words once the ring has wrapped.
+ */
+#ifndef PLAT_TF_LOG_BIN_RING_SIZE
+#define PLAT_TF_LOG_BIN_RING_SIZE	U(4096)
+#endif
+
+#define TF_LOG_BIN_RING_WORDS		((PLAT_TF_LOG_BIN_RING_SIZE - \
+					  CACHE_WRITEBACK_GRANULE) / 8U)
+
+#define TF_LOG_BIN_REC_MAGIC		ULL(0xb1)
+#define TF_LOG_BIN_REC_HDR(level, nargs, id)				\
+	((TF_LOG_BIN_REC_MAGIC << 56) | ((uint64_t)(level) << 48) |	\
+	 ((uint64_t)(nargs) << 40) | (uint64_t)(uint32_t)(id))
+
+/*
+ * Description of the rings for the decoder. It is placed at the start of the
+ * .tf_log_fmt section, so that no format string has an offset of 0.
+ */
+#define TF_LOG_BIN_INFO_MAGIC		U(0x424c4654)	/* "TFLB" */
+#define TF_LOG_BIN_INFO_VERSION		U(1)
+
+typedef struct tf_log_bin_info {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t ring_size;
+	uint32_t ring_words;
+	uint32_t num_rings;
+	uint32_t max_args;
+} tf_log_bin_info_t;
+
+typedef struct tf_log_bin_ring {
+	uint64_t head;
+	uint64_t words[TF_LOG_BIN_RING_WORDS] __aligned(CACHE_WRITEBACK_GRANULE);
+} tf_log_bin_ring_t;
+
+CASSERT(sizeof(tf_log_bin_ring_t) == PLAT_TF_LOG_BIN_RING_SIZE,
+	assert_tf_log_bin_ring_size);
+
+static const tf_log_bin_info_t tf_log_bin_info
+	__section(".tf_log_fmt.info") __used = {
+	.magic = TF_LOG_BIN_INFO_MAGIC,
+	.version = TF_LOG_BIN_INFO_VERSION,
+	.ring_size = PLAT_TF_LOG_BIN_RING_SIZE,
+	.ring_words = TF_LOG_BIN_RING_WORDS,
+	.num_rings = PLATFORM_CORE_COUNT,
+	.max_args = TF_LOG_BIN_MAX_ARGS,
+};
+
+tf_log_bin_ring_t tf_log_bin_rings[PLATFORM_CORE_COUNT]
+	__aligned(CACHE_WRITEBACK_GRANULE);
+#endif /* TF_LOG_BIN_SUPPORTED */
+
+static void tf_log_prefix(unsigned int log_level)
+{
+	const char *prefix_str = plat_log_get_prefix(log_level);
+
+	while (*prefix_str != '\0') {
+		(void)putchar(*prefix_str);
+		prefix_str++;
+	}
+}
+
 /*
  * The common log function which is invoked by TF-A code.
  * This function should not be directly invoked and is meant to be
@@ -25,7 +119,6 @@ void tf_log(const char *fmt, ...)
 {
 	unsigned int log_level;
 	va_list args;
-	const char *prefix_str;
 
 	/* We expect the LOG_MARKER_* macro as the first character */
 	log_level = fmt[0];
@@ -37,18 +130,118 @@ void tf_log(const char *fmt, ...)
 	if (log_level > max_log_level)
 		return;
 
-	prefix_str = plat_log_get_prefix(log_level);
-
-	while (*prefix_str != '\0') {
-		(void)putchar(*prefix_str);
-		prefix_str++;
-	}
+	tf_log_prefix(log_level);
 
 	va_start(args, fmt);
 	(void)vprintf(fmt + 1, args);
 	va_end(args);
 }
 
+#if TF_LOG_RATELIMIT_SUPPORTED
+/*
+ * Token bucket check for a rate limited call site. This function should not be
+ * directly invoked and is meant to be only used by the log macros defined in
+ * debug.h. It returns true if the message of the call site can be printed. The
+ * number of messages suppressed since the last one printed is reported before
+ * it. Messages filtered out by the log level do not use any token.
+ */
+bool tf_log_ratelimit(tf_log_ratelimit_t *rl, const char log_fmt[2])
+{
+	unsigned int log_level = log_fmt[0];
+	unsigned int suppressed = 0U;
+	uint64_t now, period, refill;
+	bool allow;
+
+	if (log_level > max_log_level)
+		return false;
+
+	/* The lock cannot be used until the data cache is enabled */
+	if ((read_sctlr_el3() & SCTLR_C_BIT) == 0U)
+		return true;
+
+	period = (read_cntfrq_el0() * PLAT_LOG_RATELIMIT_INTERVAL_MS) /
+		 (1000ULL * PLAT_LOG_RATELIMIT_BURST);
+	now = read_cntpct_el0();
+
+	spin_lock(&rl->lock);
+
+	refill = (period != 0U) ? ((now - rl->last) / period) : UINT64_MAX;
+	if (refill >= rl->used) {
+		rl->used = 0U;
+		rl->last = now;
+	} else {
+		rl->used -= (unsigned int)refill;
+		rl->last += refill * period;
+	}
+
+	allow = rl->used < PLAT_LOG_RATELIMIT_BURST;
+	if (allow) {
+		rl->used++;
+		suppressed = rl->suppressed;
+		rl->suppressed = 0U;
+	} else {
+		rl->suppressed++;
+	}
+
+	spin_unlock(&rl->lock);
+
+	if (suppressed != 0U) {
+		tf_log_prefix(log_level);
+		(void)printf("%u similar messages suppressed\n", suppressed);
+	}
+
+	return allow;
+}
+#endif /* TF_LOG_RATELIMIT_SUPPORTED */
+
+#if TF_LOG_BIN_SUPPORTED
+static inline void tf_log_bin_put(tf_log_bin_ring_t *ring, unsigned int *idx,
+				  uint64_t word)
+{
+	ring->words[*idx] = word;
+	if (++(*idx) == TF_LOG_BIN_RING_WORDS) {
+		*idx = 0U;
+	}
+}
+
+/*
+ * Record a message in the binary log of the current CPU. This function should
+ * not be directly invoked and is meant to be only used by the log macros
+ * defined in debug.h. Each variadic argument is read as a 64-bit word, as
+ * AArch64 passes each of them in its own register or stack slot. The upper
+ * bits of 32-bit arguments are ignored by the decoder.
+ */
+void tf_log_bin(unsigned int log_level, uintptr_t fmt_id, unsigned int nargs,
+		...)
+{
+	tf_log_bin_ring_t *ring;
+	unsigned int i, idx;
+	va_list args;
+
+	assert((log_level > 0U) && (log_level <= LOG_LEVEL_VERBOSE));
+	assert(nargs <= TF_LOG_BIN_MAX_ARGS);
+
+	if (log_level > max_log_level)
+		return;
+
+	ring = &tf_log_bin_rings[plat_my_core_pos()];
+	idx = (unsigned int)(ring->head % TF_LOG_BIN_RING_WORDS);
+
+	tf_log_bin_put(ring, &idx, TF_LOG_BIN_REC_HDR(log_level, nargs, fmt_id));
+	tf_log_bin_put(ring, &idx, read_cntpct_el0());
+
+	va_start(args, nargs);
+	for (i = 0U; i < nargs; i++) {
+		tf_log_bin_put(ring, &idx, va_arg(args, uint64_t));
+	}
+	va_end(args);
+
+	dmbishst();
+
+	ring->head += 2U + nargs;
+}
+#endif /* TF_LOG_BIN_SUPPORTED */
+
 void tf_log_newline(const char log_fmt[2])
 {
 	unsigned int log_level = log_fmt[0];
@@ -77,3 +270,9 @@ void tf_log_set_max_level(unsigned int log_level)
 	if (log_level <= (unsigned int)LOG_LEVEL)
 		max_log_level = log_level;
 }
+
+/* Return the current maximum log level. */
+unsigned int tf_log_get_max_level(void)
+{
+	return max_log_level;
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdint.h>
+
+#include <common/debug.h>
+#include <common/runtime_svc.h>
+#include <common/tf_log_smc.h>
+#include <smccc_helpers.h>
+
+/*
+ * This function handles the SMC calls reading and changing the maximum log
+ * level of BL31.
+ */
+uintptr_t tf_log_smc_handler(unsigned int smc_fid,
+			     u_register_t x1,
+			     u_register_t x2,
+			     u_register_t x3,
+			     u_register_t x4,
+			     void *cookie,
+			     void *handle,
+			     u_register_t flags)
+{
+	int rc = TF_LOG_E_SUCCESS;
+
+	/* Allow calls from non-secure only */
+	if (is_caller_secure(flags)) {
+		SMC_RET1(handle, TF_LOG_E_DENIED);
+	}
+
+	if ((smc_fid != TF_LOG_SMC_32) && (smc_fid != TF_LOG_SMC_64)) {
+		WARN("Unimplemented TF_LOG Call: 0x%x\n", smc_fid);
+		SMC_RET1(handle, SMC_UNK);
+	}
+
+	/* Truncate parameters if 32b SMC convention call */
+	if (GET_SMC_CC(smc_fid) == SMC_32) {
+		x1 = (uint32_t)x1;
+		x2 = (uint32_t)x2;
+	}
+
+	switch (x1) {
+	case TF_LOG_SMC_GET_LEVEL:
+		break;
+
+	case TF_LOG_SMC_SET_LEVEL:
+		if ((x2 > LOG_LEVEL) || ((x2 % 10U) != 0U)) {
+			rc = TF_LOG_E_INVALID_PARAMS;
+			break;
+		}
+
+		tf_log_set_max_level((unsigned int)x2);
+		break;
+
+	default:
+		rc = TF_LOG_E_INVALID_PARAMS;
+		break;
+	}
+
+	SMC_RET3(handle, rc, tf_log_get_max_level(), LOG_LEVEL);
+}
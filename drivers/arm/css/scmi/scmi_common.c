@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2019, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2023, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -8,10 +8,16 @@
 
 #include <arch_helpers.h>
 #include <common/debug.h>
+#include <common/runtime_svc.h>
 #include <drivers/arm/css/scmi.h>
+#include <drivers/arm/css/scmi_stats.h>
+#include <lib/utils.h>
+#include <plat/common/platform.h>
 
 #include "scmi_private.h"
 
+#include <platform_def.h>
+
 #if HW_ASSISTED_COHERENCY
 #define scmi_lock_init(lock)
 #define scmi_lock_get(lock)		spin_lock(lock)
@@ -23,23 +29,270 @@
 #endif
 
 
+#if CSS_SCMI_STATS
+typedef struct scmi_stats {
+	/* Number of commands for which the response was waited for */
+	uint64_t sync_count;
+	/* Total and maximum time waiting for the response of a command */
+	uint64_t sync_ticks_total;
+	uint64_t sync_ticks_max;
+	/* Number of commands posted without waiting for the response */
+	uint64_t posted_count;
+	/* Number of times the channel was still busy with a posted command */
+	uint64_t busy_count;
+	/* Total time waiting for a posted command to complete */
+	uint64_t busy_ticks_total;
+} scmi_stats_t;
+
+/*
+ * Statistics of a CPU, only written by this CPU, possibly with the data cache
+ * disabled on the power down path. 'gen' is the reset generation the
+ * statistics belong to: the CPU clears them before recording anything once a
+ * reset was requested.
+ */
+typedef struct scmi_cpu_stats {
+	scmi_stats_t stats;
+	unsigned int gen;
+} __aligned(CACHE_WRITEBACK_GRANULE) scmi_cpu_stats_t;
+
+static scmi_cpu_stats_t scmi_cpu_stats[PLATFORM_CORE_COUNT];
+
+/* Reset generation requested by the Normal world */
+static volatile unsigned int scmi_stats_gen
+	__aligned(CACHE_WRITEBACK_GRANULE);
+
+static scmi_stats_t *scmi_my_stats(void)
+{
+	scmi_cpu_stats_t *cpu_stats = &scmi_cpu_stats[plat_my_core_pos()];
+	unsigned int gen = scmi_stats_gen;
+
+	if (cpu_stats->gen != gen) {
+		zeromem(&cpu_stats->stats, sizeof(cpu_stats->stats));
+		cpu_stats->gen = gen;
+	}
+
+	return &cpu_stats->stats;
+}
+
+static void scmi_stats_flush(scmi_stats_t *stats)
+{
+#if !HW_ASSISTED_COHERENCY
+	flush_dcache_range((uintptr_t)stats, sizeof(scmi_cpu_stats_t));
+#endif
+}
+
+static void scmi_stats_sync(uint64_t ticks)
+{
+	scmi_stats_t *stats = scmi_my_stats();
+
+	stats->sync_count++;
+	stats->sync_ticks_total += ticks;
+	if (ticks > stats->sync_ticks_max) {
+		stats->sync_ticks_max = ticks;
+	}
+	scmi_stats_flush(stats);
+}
+
+static void scmi_stats_posted(void)
+{
+	scmi_stats_t *stats = scmi_my_stats();
+
+	stats->posted_count++;
+	scmi_stats_flush(stats);
+}
+
+static void scmi_stats_busy(uint64_t ticks)
+{
+	scmi_stats_t *stats = scmi_my_stats();
+
+	stats->busy_count++;
+	stats->busy_ticks_total += ticks;
+	scmi_stats_flush(stats);
+}
+
+/*
+ * This function handles the SMC calls reading and resetting the SCMI command
+ * statistics. The statistics of a CPU are read while it may update them, so
+ * the fields may be from two consecutive updates.
+ */
+uintptr_t scmi_stats_smc_handler(unsigned int smc_fid,
+				 u_register_t x1,
+				 u_register_t x2,
+				 u_register_t x3,
+				 u_register_t x4,
+				 void *cookie,
+				 void *handle,
+				 u_register_t flags)
+{
+	const scmi_cpu_stats_t *cpu_stats;
+	int cpu_idx;
+
+	/* Allow calls from non-secure only */
+	if (is_caller_secure(flags)) {
+		SMC_RET1(handle, SCMI_STATS_E_DENIED);
+	}
+
+	if ((smc_fid != SCMI_STATS_SMC_32) && (smc_fid != SCMI_STATS_SMC_64)) {
+		WARN("Unimplemented SCMI_STATS Call: 0x%x\n", smc_fid);
+		SMC_RET1(handle, SMC_UNK);
+	}
+
+	/* Truncate parameters if 32b SMC convention call */
+	if (GET_SMC_CC(smc_fid) == SMC_32) {
+		x1 = (uint32_t)x1;
+		x2 = (uint32_t)x2;
+	}
+
+	switch (x1) {
+	case SCMI_STATS_SMC_GET:
+		cpu_idx = plat_core_pos_by_mpidr(x2);
+		if (cpu_idx < 0) {
+			SMC_RET1(handle, SCMI_STATS_E_INVALID_PARAMS);
+		}
+
+		cpu_stats = &scmi_cpu_stats[cpu_idx];
+#if !HW_ASSISTED_COHERENCY
+		inv_dcache_range((uintptr_t)cpu_stats, sizeof(*cpu_stats));
+#endif
+		if (cpu_stats->gen != scmi_stats_gen) {
+			/* Reset, and not updated since */
+			SMC_RET7(handle, SCMI_STATS_E_SUCCESS, 0, 0, 0, 0, 0, 0);
+		}
+
+		SMC_RET7(handle, SCMI_STATS_E_SUCCESS,
+			 cpu_stats->stats.sync_count,
+			 cpu_stats->stats.sync_ticks_total,
+			 cpu_stats->stats.sync_ticks_max,
+			 cpu_stats->stats.posted_count,
+			 cpu_stats->stats.busy_count,
+			 cpu_stats->stats.busy_ticks_total);
+
+	case SCMI_STATS_SMC_RESET:
+		scmi_stats_gen = scmi_stats_gen + 1U;
+#if !HW_ASSISTED_COHERENCY
+		/* CPUs powering down may read it with the data cache disabled */
+		flush_dcache_range((uintptr_t)&scmi_stats_gen,
+				   sizeof(scmi_stats_gen));
+#endif
+		SMC_RET1(handle, SCMI_STATS_E_SUCCESS);
+
+	default:
+		SMC_RET1(handle, SCMI_STATS_E_INVALID_PARAMS);
+	}
+}
+
+#define scmi_stats_timestamp()		read_cntpct_el0()
+#else
+static inline void scmi_stats_sync(uint64_t ticks) { (void)ticks; }
+static inline void scmi_stats_posted(void) { }
+static inline void scmi_stats_busy(uint64_t ticks) { (void)ticks; }
+#define scmi_stats_timestamp()		0ULL
+#endif /* CSS_SCMI_STATS */
+
+#if CSS_SCMI_WFE_WAIT
+/*
+ * Private helper function to enable the event stream of the generic timer, so
+ * that the wait for the SCP can be done in WFE. The SCP does not signal events
+ * to the AP, so the events of the stream are what wakes the CPU up to check
+ * the channel status again. The period is the smallest one of at least a
+ * microsecond. The previous value of CNTKCTL_EL1 is returned, to be restored
+ * once the channel is free.
+ */
+static u_register_t scmi_event_stream_enable(void)
+{
+	u_register_t cntkctl = read_cntkctl_el1();
+	uint64_t ticks_per_us = read_cntfrq_el0() / 1000000U;
+	unsigned int evnti = 0U;
+
+	/* An event is generated every 2^(EVNTI + 1) ticks */
+	while ((evnti < EVNTI_MASK) && ((2ULL << evnti) < ticks_per_us)) {
+		evnti++;
+	}
+
+	write_cntkctl_el1((cntkctl & ~((EVNTI_MASK << EVNTI_SHIFT) |
+					EVNTDIR_BIT | EVNTIS_BIT)) |
+			  EVNTEN_BIT | (evnti << EVNTI_SHIFT));
+	isb();
+
+	return cntkctl;
+}
+#endif /* CSS_SCMI_WFE_WAIT */
+
+/*
+ * Private helper function to wait for the SCP to hand the channel back to the
+ * AP.
+ */
+void scmi_wait_channel_free(scmi_channel_t *ch)
+{
+	mailbox_mem_t *mbx_mem = (mailbox_mem_t *)(ch->info->scmi_mbx_mem);
+
+#if CSS_SCMI_WFE_WAIT
+	if (!SCMI_IS_CHANNEL_FREE(mbx_mem->status)) {
+		u_register_t cntkctl = scmi_event_stream_enable();
+
+		while (!SCMI_IS_CHANNEL_FREE(mbx_mem->status)) {
+			wfe();
+		}
+
+		write_cntkctl_el1(cntkctl);
+		isb();
+	}
+#else
+	while (!SCMI_IS_CHANNEL_FREE(mbx_mem->status))
+		;
+#endif
+
+	/*
+	 * Ensure that any read to the SCMI payload area is done after reading
+	 * mailbox status. If these 2 reads were reordered then the CPU would
+	 * read invalid payload data
+	 */
+	dmbld();
+}
+
+/*
+ * Private helper functions to take and release exclusive access to SCMI
+ * channel, without waiting for the SCP to complete a command posted by the
+ * previous owner.
+ */
+void scmi_lock_channel(scmi_channel_t *ch)
+{
+	assert(ch->lock);
+	scmi_lock_get(ch->lock);
+}
+
+void scmi_unlock_channel(scmi_channel_t *ch)
+{
+	assert(ch->lock);
+	scmi_lock_release(ch->lock);
+}
+
 /*
  * Private helper function to get exclusive access to SCMI channel.
  */
 void scmi_get_channel(scmi_channel_t *ch)
 {
+	mailbox_mem_t *mbx_mem = (mailbox_mem_t *)(ch->info->scmi_mbx_mem);
+
 	assert(ch->lock);
 	scmi_lock_get(ch->lock);
 
-	/* Make sure any previous command has finished */
-	assert(SCMI_IS_CHANNEL_FREE(
-			((mailbox_mem_t *)(ch->info->scmi_mbx_mem))->status));
+	/*
+	 * A command posted by the previous owner of the channel may still be
+	 * in progress, wait for the SCP to finish with it.
+	 */
+	if (!SCMI_IS_CHANNEL_FREE(mbx_mem->status)) {
+		uint64_t start = scmi_stats_timestamp();
+
+		scmi_wait_channel_free(ch);
+		scmi_stats_busy(scmi_stats_timestamp() - start);
+	}
 }
 
 /*
- * Private helper function to transfer ownership of channel from AP to SCP.
+ * Private helper function to hand the channel over to the SCP.
  */
-void scmi_send_sync_command(scmi_channel_t *ch)
+static void scmi_ring_doorbell(scmi_channel_t *ch)
 {
 	mailbox_mem_t *mbx_mem = (mailbox_mem_t *)(ch->info->scmi_mbx_mem);
 
@@ -53,6 +306,17 @@ void scmi_send_sync_command(scmi_channel_t *ch)
 	dmbst();
 
 	ch->info->ring_doorbell(ch->info);
+}
+
+/*
+ * Private helper function to transfer ownership of channel from AP to SCP.
+ */
+void scmi_send_sync_command(scmi_channel_t *ch)
+{
+	uint64_t start = scmi_stats_timestamp();
+
+	scmi_ring_doorbell(ch);
+
 	/*
 	 * Ensure that the write to the doorbell register is ordered prior to
 	 * checking whether the channel is free.
@@ -60,15 +324,22 @@ void scmi_send_sync_command(scmi_channel_t *ch)
 	dmbsy();
 
 	/* Wait for channel to be free */
-	while (!SCMI_IS_CHANNEL_FREE(mbx_mem->status))
-		;
+	scmi_wait_channel_free(ch);
 
-	/*
-	 * Ensure that any read to the SCMI payload area is done after reading
-	 * mailbox status. If these 2 reads were reordered then the CPU would
-	 * read invalid payload data
-	 */
-	dmbld();
+	scmi_stats_sync(scmi_stats_timestamp() - start);
+}
+
+/*
+ * Private helper function to transfer ownership of channel from AP to SCP
+ * without waiting for the response. The response is discarded; the next
+ * owner of the channel waits for the SCP to complete the command before using
+ * the channel.
+ */
+void scmi_post_command(scmi_channel_t *ch)
+{
+	scmi_ring_doorbell(ch);
+
+	scmi_stats_posted();
 }
 
 /*
@@ -84,6 +355,29 @@ void scmi_put_channel(scmi_channel_t *ch)
 	scmi_lock_release(ch->lock);
 }
 
+/*
+ * API to check whether a channel looks idle, i.e. is neither held by another
+ * CPU nor still in use by the SCP for a posted command. The result is only a
+ * hint, the channel may be taken by another CPU right after this returns.
+ * Ownership by another CPU can only be observed with spinlocks; with bakery
+ * locks only the mailbox status is checked.
+ */
+bool scmi_channel_is_idle(void *p)
+{
+	scmi_channel_t *ch = (scmi_channel_t *)p;
+
+	validate_scmi_channel(ch);
+
+#if HW_ASSISTED_COHERENCY
+	if (ch->lock->lock != 0U) {
+		return false;
+	}
+#endif
+
+	return SCMI_IS_CHANNEL_FREE(
+			((mailbox_mem_t *)(ch->info->scmi_mbx_mem))->status);
+}
+
 /*
  * API to query the SCMI protocol version.
  */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2023, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -9,6 +9,10 @@
 
 #include <lib/mmio.h>
 
+#ifndef CSS_SCMI_WFE_WAIT
+#define CSS_SCMI_WFE_WAIT			0
+#endif
+
 /*
  * SCMI power domain management protocol message and response lengths. It is
  * calculated as sum of length in bytes of the message header (4) and payload
@@ -142,8 +146,12 @@ typedef struct mailbox_mem {
 
 
 /* Private APIs for use within SCMI driver */
+void scmi_lock_channel(scmi_channel_t *ch);
+void scmi_unlock_channel(scmi_channel_t *ch);
+void scmi_wait_channel_free(scmi_channel_t *ch);
 void scmi_get_channel(scmi_channel_t *ch);
 void scmi_send_sync_command(scmi_channel_t *ch);
+void scmi_post_command(scmi_channel_t *ch);
 void scmi_put_channel(scmi_channel_t *ch);
 
 static inline void validate_scmi_channel(scmi_channel_t *ch)
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2019, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2023, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -53,6 +53,145 @@ int scmi_pwr_state_set(void *p, uint32_t domain_id,
 	return ret;
 }
 
+/*
+ * Private helper function to write a POWER_STATE_SET request to the channel
+ * and hand it over to the SCP without waiting for the response. The channel
+ * must be held and free.
+ */
+static void scmi_pwr_state_post(scmi_channel_t *ch, uint32_t domain_id,
+				uint32_t scmi_pwr_state)
+{
+	mailbox_mem_t *mbx_mem = (mailbox_mem_t *)(ch->info->scmi_mbx_mem);
+	unsigned int token = 0;
+
+	mbx_mem->msg_header = SCMI_MSG_CREATE(SCMI_PWR_DMN_PROTO_ID,
+			SCMI_PWR_STATE_SET_MSG, token);
+	mbx_mem->len = SCMI_PWR_STATE_SET_MSG_LEN;
+	mbx_mem->flags = SCMI_FLAG_RESP_POLL;
+	SCMI_PAYLOAD_ARG3(mbx_mem->payload, SCMI_PWR_STATE_SET_FLAG_ASYNC,
+						domain_id, scmi_pwr_state);
+
+	scmi_post_command(ch);
+}
+
+/*
+ * API to post a request to set the SCMI power domain power state, without
+ * waiting for the SCP to respond. This is meant for power down requests on
+ * the CPU_OFF and CPU_SUSPEND paths, where the calling CPU has nothing to do
+ * with the result other than to enter WFI. Since the response is not read,
+ * errors reported by the SCP are not detected.
+ */
+int scmi_pwr_state_set_posted(void *p, uint32_t domain_id,
+			      uint32_t scmi_pwr_state)
+{
+	scmi_channel_t *ch = (scmi_channel_t *)p;
+
+	validate_scmi_channel(ch);
+
+	scmi_get_channel(ch);
+
+	scmi_pwr_state_post(ch, domain_id, scmi_pwr_state);
+
+	scmi_unlock_channel(ch);
+
+	return SCMI_E_QUEUED;
+}
+
+/*
+ * Private helper function to post the oldest queued power up request. The
+ * channel must be held and free.
+ */
+static void scmi_pwr_state_post_next(scmi_channel_t *ch)
+{
+	unsigned int i;
+
+	assert(ch->queue_count != 0U);
+
+	scmi_pwr_state_post(ch, ch->queue[0].domain_id,
+			    ch->queue[0].scmi_pwr_state);
+	ch->kick_count++;
+
+	ch->queue_count--;
+	for (i = 0U; i < ch->queue_count; i++) {
+		ch->queue[i] = ch->queue[i + 1U];
+	}
+}
+
+/*
+ * API to request the power up of a power domain without waiting for the SCMI
+ * channel. The request is posted if the channel is free. Otherwise it is
+ * queued, as long as an earlier posted power up request is pending: the CPU
+ * it powers up calls scmi_pwr_state_kick(), which posts the next queued
+ * request once the channel is free. Without such a request, or when the queue
+ * is full, the caller waits for the channel like scmi_pwr_state_set_posted().
+ *
+ * The caller thus only waits for the SCP when it cannot rely on another CPU to
+ * send its request, and a burst of CPU_ON calls does not serialize the callers
+ * on the SCP round trips. Since the response is not read, errors reported by
+ * the SCP are not detected.
+ */
+int scmi_pwr_state_set_queued(void *p, uint32_t domain_id,
+			      uint32_t scmi_pwr_state)
+{
+	mailbox_mem_t *mbx_mem;
+	scmi_channel_t *ch = (scmi_channel_t *)p;
+
+	validate_scmi_channel(ch);
+
+	scmi_lock_channel(ch);
+
+	mbx_mem = (mailbox_mem_t *)(ch->info->scmi_mbx_mem);
+
+	if ((ch->kick_count == 0U) ||
+	    (ch->queue_count == SCMI_PWR_STATE_QUEUE_LEN)) {
+		scmi_wait_channel_free(ch);
+	}
+
+	/* Requests queued earlier go first, this also makes room in the queue */
+	if (SCMI_IS_CHANNEL_FREE(mbx_mem->status) && (ch->queue_count != 0U)) {
+		scmi_pwr_state_post_next(ch);
+	}
+
+	assert(ch->queue_count < SCMI_PWR_STATE_QUEUE_LEN);
+	ch->queue[ch->queue_count].domain_id = domain_id;
+	ch->queue[ch->queue_count].scmi_pwr_state = scmi_pwr_state;
+	ch->queue_count++;
+
+	if (SCMI_IS_CHANNEL_FREE(mbx_mem->status)) {
+		scmi_pwr_state_post_next(ch);
+	}
+
+	scmi_unlock_channel(ch);
+
+	return SCMI_E_QUEUED;
+}
+
+/*
+ * API to be called by a CPU powered up by a request posted through
+ * scmi_pwr_state_set_queued(), once it runs coherently with the other CPUs.
+ * The SCP has handled the request, so the next queued request is posted.
+ */
+void scmi_pwr_state_kick(void *p)
+{
+	scmi_channel_t *ch = (scmi_channel_t *)p;
+
+	validate_scmi_channel(ch);
+
+	scmi_lock_channel(ch);
+
+	/* The CPU may not have been powered up by a queued request */
+	if (ch->kick_count != 0U) {
+		ch->kick_count--;
+	}
+
+	if (ch->queue_count != 0U) {
+		scmi_wait_channel_free(ch);
+		scmi_pwr_state_post_next(ch);
+	}
+
+	scmi_unlock_channel(ch);
+}
+
 /*
  * API to get the SCMI power domain power state.
  */
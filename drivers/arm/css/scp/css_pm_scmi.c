@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2022, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2023, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -79,11 +79,50 @@ static scmi_channel_t scmi_channels[PLAT_ARM_SCMI_CHANNEL_COUNT];
  */
 static uint32_t default_scmi_channel_id;
 
+/* Each SCMI channel is protected by its own lock. */
+ARM_SCMI_INSTANTIATE_LOCK;
+
 /*
- * TODO: Allow use of channel specific lock instead of using a single lock for
- * all the channels.
+ * Platforms may provide several SCMI channels to the same SCP agent, so that
+ * cores in different clusters can issue power requests in parallel. In that
+ * case, the channels are grouped in pools of PLAT_ARM_SCMI_CHANNEL_POOL_SIZE
+ * consecutive channels which must expose the same power domain IDs. The
+ * channel encoded in plat_css_core_pos_to_scmi_dmn_id_map[] for a core is its
+ * preferred channel, and another idle channel of the same pool is used when
+ * the preferred one is busy.
  */
-ARM_SCMI_INSTANTIATE_LOCK;
+#ifndef PLAT_ARM_SCMI_CHANNEL_POOL_SIZE
+#define PLAT_ARM_SCMI_CHANNEL_POOL_SIZE		U(1)
+#endif
+
+CASSERT((PLAT_ARM_SCMI_CHANNEL_COUNT % PLAT_ARM_SCMI_CHANNEL_POOL_SIZE) == 0U,
+	assert_scmi_channel_pool_size_mismatch);
+
+/*
+ * Function to select an SCMI channel of the pool containing the preferred
+ * channel. The preferred channel is returned if it is idle or if no other
+ * channel of the pool is idle.
+ */
+static unsigned int css_scp_select_scmi_channel(unsigned int channel_id)
+{
+#if PLAT_ARM_SCMI_CHANNEL_POOL_SIZE > 1
+	unsigned int pool_base, idx, candidate;
+
+	if (scmi_channel_is_idle(scmi_handles[channel_id])) {
+		return channel_id;
+	}
+
+	pool_base = channel_id - (channel_id % PLAT_ARM_SCMI_CHANNEL_POOL_SIZE);
+	for (idx = 1U; idx < PLAT_ARM_SCMI_CHANNEL_POOL_SIZE; idx++) {
+		candidate = pool_base + ((channel_id + idx) %
+					 PLAT_ARM_SCMI_CHANNEL_POOL_SIZE);
+		if (scmi_channel_is_idle(scmi_handles[candidate])) {
+			return candidate;
+		}
+	}
+#endif
+	return channel_id;
+}
 
 /*
  * Function to obtain the SCMI Domain ID and SCMI Channel number from the linear
@@ -98,10 +137,58 @@ static void css_scp_core_pos_to_scmi_channel(unsigned int core_pos,
 
 	composite_id = plat_css_core_pos_to_scmi_dmn_id_map[core_pos];
 
-	*scmi_channel_id = GET_SCMI_CHANNEL_ID(composite_id);
+	*scmi_channel_id = css_scp_select_scmi_channel(
+				GET_SCMI_CHANNEL_ID(composite_id));
 	*scmi_domain_id = GET_SCMI_DOMAIN_ID(composite_id);
 }
 
+/*
+ * Helper function to request the power down of the calling CPU and its parent
+ * power domains. With CSS_SCMI_POST_PWR_DOWN, the request is posted and the
+ * channel is released without waiting for the SCP to respond.
+ */
+static int css_scp_pwr_down_state_set(void *scmi_handle, uint32_t domain_id,
+				      uint32_t scmi_pwr_state)
+{
+#if CSS_SCMI_POST_PWR_DOWN
+	return scmi_pwr_state_set_posted(scmi_handle, domain_id,
+					 scmi_pwr_state);
+#else
+	return scmi_pwr_state_set(scmi_handle, domain_id, scmi_pwr_state);
+#endif
+}
+
+#if CSS_SCMI_POST_PWR_ON
+/*
+ * SCMI channel used for the power up request of each CPU, so that the CPU can
+ * post the next queued request of that channel once it runs.
+ */
+static unsigned int css_scp_pwr_up_channel_id[PLATFORM_CORE_COUNT];
+#endif
+
+/*
+ * Helper function to request the power up of a CPU and its parent power
+ * domains. With CSS_SCMI_POST_PWR_ON, the request is queued on the channel
+ * instead of waiting for it to be free. The calling CPU returns to the caller
+ * of CPU_ON right away, and each CPU that is powered up posts the next queued
+ * request from css_scp_on_finish(). A burst of CPU_ON calls during secondary
+ * CPU bring-up then does not serialize the callers on the SCP round trips.
+ */
+static int css_scp_pwr_up_state_set(unsigned int core_pos,
+				    unsigned int channel_id, uint32_t domain_id,
+				    uint32_t scmi_pwr_state)
+{
+#if CSS_SCMI_POST_PWR_ON
+	css_scp_pwr_up_channel_id[core_pos] = channel_id;
+
+	return scmi_pwr_state_set_queued(scmi_handles[channel_id], domain_id,
+					 scmi_pwr_state);
+#else
+	return scmi_pwr_state_set(scmi_handles[channel_id], domain_id,
+				  scmi_pwr_state);
+#endif
+}
+
 /*
  * Helper function to suspend a CPU power domain and its parent power domains
  * if applicable.
@@ -158,10 +245,10 @@ void css_scp_suspend(const struct psci_power_state *target_state)
 
 	css_scp_core_pos_to_scmi_channel(plat_my_core_pos(),
 			&domain_id, &channel_id);
-	ret = scmi_pwr_state_set(scmi_handles[channel_id],
+	ret = css_scp_pwr_down_state_set(scmi_handles[channel_id],
 		domain_id, scmi_pwr_state);
 
-	if (ret != SCMI_E_SUCCESS) {
+	if (ret != SCMI_E_QUEUED && ret != SCMI_E_SUCCESS) {
 		ERROR("SCMI set power state command return 0x%x unexpected\n",
 				ret);
 		panic();
@@ -200,7 +287,7 @@ void css_scp_off(const struct psci_power_state *target_state)
 
 	css_scp_core_pos_to_scmi_channel(plat_my_core_pos(),
 			&domain_id, &channel_id);
-	ret = scmi_pwr_state_set(scmi_handles[channel_id],
+	ret = css_scp_pwr_down_state_set(scmi_handles[channel_id],
 		domain_id, scmi_pwr_state);
 	if (ret != SCMI_E_QUEUED && ret != SCMI_E_SUCCESS) {
 		ERROR("SCMI set power state command return 0x%x unexpected\n",
@@ -230,8 +317,8 @@ void css_scp_on(u_register_t mpidr)
 
 	css_scp_core_pos_to_scmi_channel(core_pos, &domain_id,
 			&channel_id);
-	ret = scmi_pwr_state_set(scmi_handles[channel_id],
-		domain_id, scmi_pwr_state);
+	ret = css_scp_pwr_up_state_set(core_pos, channel_id, domain_id,
+		scmi_pwr_state);
 	if (ret != SCMI_E_QUEUED && ret != SCMI_E_SUCCESS) {
 		ERROR("SCMI set power state command return 0x%x unexpected\n",
 				ret);
@@ -239,6 +326,21 @@ void css_scp_on(u_register_t mpidr)
 	}
 }
 
+/*
+ * Helper function called by a CPU once it has been powered up and runs
+ * coherently with the other CPUs. With CSS_SCMI_POST_PWR_ON, the SCP has
+ * handled the power up request of this CPU, so the next power up request
+ * queued on the same channel is posted.
+ */
+void css_scp_on_finish(void)
+{
+#if CSS_SCMI_POST_PWR_ON
+	unsigned int channel_id = css_scp_pwr_up_channel_id[plat_my_core_pos()];
+
+	scmi_pwr_state_kick(scmi_handles[channel_id]);
+#endif
+}
+
 /*
  * Helper function to get the power state of a power domain node as reported
  * by the SCP.
@@ -391,7 +493,7 @@ void __init plat_arm_pwrc_setup(void)
 		INFO("Initializing SCMI driver on channel %d\n", idx);
 
 		scmi_channels[idx].info = plat_css_get_scmi_info(idx);
-		scmi_channels[idx].lock = ARM_SCMI_LOCK_GET_INSTANCE;
+		scmi_channels[idx].lock = ARM_SCMI_LOCK_GET_INSTANCE(idx);
 		scmi_handles[idx] = scmi_init(&scmi_channels[idx]);
 
 		if (scmi_handles[idx] == NULL) {
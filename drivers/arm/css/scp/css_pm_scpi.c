@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2023, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -67,6 +67,14 @@ void css_scp_on(u_register_t mpidr)
 				 scpi_power_on);
 }
 
+/*
+ * Helper function called by a CPU once it has been powered up. Nothing to do
+ * with SCPI.
+ */
+void css_scp_on_finish(void)
+{
+}
+
 /*
  * Helper function to get the power state of a power domain node as reported
  * by the SCP.
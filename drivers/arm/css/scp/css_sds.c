@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2014-2017, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2014-2023, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -91,5 +91,6 @@ int css_scp_boot_ready(void)
 	ERROR("Timeout of %d ms expired waiting for SCP RAM Ready flag\n",
 			CSS_SCP_READY_10US_RETRIES/100);
 
+	console_flush();
 	plat_panic_handler();
 }
@@ -1,5 +1,5 @@
 #
-# Copyright (c) 2013-2022, Arm Limited and Contributors. All rights reserved.
+# Copyright (c) 2013-2023, Arm Limited and Contributors. All rights reserved.
 # Copyright (c) 2021, NVIDIA Corporation. All rights reserved.
 #
 # SPDX-License-Identifier: BSD-3-Clause
@@ -13,6 +13,7 @@ GICV3_OVERRIDE_DISTIF_PWR_OPS	?=	0
 GIC_ENABLE_V4_EXTN		?=	0
 GIC_EXT_INTID			?=	0
 GIC600_ERRATA_WA_2384374	?=	${GICV3_SUPPORT_GIC600}
+GICV3_RDISTIF_MAP_AT_INIT	?=	0
 
 GICV3_SOURCES	+=	drivers/arm/gic/v3/gicv3_main.c		\
 			drivers/arm/gic/v3/gicv3_helpers.c	\
@@ -56,3 +57,7 @@ $(eval $(call add_define,GIC_EXT_INTID))
 # Set errata workaround for GIC600/GIC600AE
 $(eval $(call assert_boolean,GIC600_ERRATA_WA_2384374))
 $(eval $(call add_define,GIC600_ERRATA_WA_2384374))
+
+# Set single walk of the Redistributor frames
+$(eval $(call assert_boolean,GICV3_RDISTIF_MAP_AT_INIT))
+$(eval $(call add_define,GICV3_RDISTIF_MAP_AT_INIT))
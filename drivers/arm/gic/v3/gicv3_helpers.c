@@ -6,6 +6,7 @@
  */
 
 #include <assert.h>
+#include <string.h>
 
 #include <arch.h>
 #include <arch_helpers.h>
@@ -66,9 +67,11 @@ void gicv3_rdistif_mark_core_asleep(uintptr_t gicr_base)
 /*******************************************************************************
  * This function probes the Redistributor frames when the driver is initialised
  * and saves their base addresses. These base addresses are used later to
- * initialise each Redistributor interface.
+ * initialise each Redistributor interface. If 'rdistif_typer' is not NULL, the
+ * GICR_TYPER of each Redistributor is saved in it as well.
  ******************************************************************************/
 void gicv3_rdistif_base_addrs_probe(uintptr_t *rdistif_base_addrs,
+					uint64_t *rdistif_typer,
 					unsigned int rdistif_num,
 					uintptr_t gicr_base,
 					mpidr_hash_fn mpidr_to_core_pos)
@@ -99,6 +102,9 @@ void gicv3_rdistif_base_addrs_probe(uintptr_t *rdistif_base_addrs,
 
 		if (proc_num < rdistif_num) {
 			rdistif_base_addrs[proc_num] = rdistif_base;
+			if (rdistif_typer != NULL) {
+				rdistif_typer[proc_num] = typer_val;
+			}
 		}
 		rdistif_base += gicv3_redist_size(typer_val);
 	} while ((typer_val & TYPER_LAST_BIT) == 0U);
@@ -202,6 +208,131 @@ void gicv3_spis_config_defaults(uintptr_t gicd_base)
 #endif
 }
 
+/*
+ * Secure interrupt properties are applied in blocks of 32 interrupts, the
+ * interrupts covered by one IGROUPR register, so that each GIC register is
+ * written once for all the interrupts it holds instead of once per interrupt.
+ */
+typedef struct gicv3_props_block {
+	/* First interrupt ID of the block */
+	unsigned int base_id;
+	/* Interrupts of the block with properties */
+	uint32_t intr_mask;
+	/* Values of the IGRPMODR, ICFGR and IPRIORITYR registers to write */
+	uint32_t grpmod;
+	uint32_t cfg_mask[2];
+	uint32_t cfg[2];
+	uint32_t pri_mask[8];
+	uint32_t pri[8];
+	unsigned int ctlr_enable;
+} gicv3_props_block_t;
+
+static bool gicv3_props_match(unsigned int intr_num, bool spi)
+{
+	return spi ? IS_SPI(intr_num) : IS_SGI_PPI(intr_num);
+}
+
+static void gicv3_props_block_add(gicv3_props_block_t *blk,
+				  const interrupt_prop_t *prop)
+{
+	unsigned int n = prop->intr_num - blk->base_id;
+	unsigned int cfg_shift = (n & 15U) << 1;
+	unsigned int pri_shift = (n & 3U) << 3;
+	uint32_t bit = (uint32_t)1 << n;
+
+	/* Configure this interrupt as G0 or a G1S interrupt */
+	assert((prop->intr_grp == INTR_GROUP0) ||
+	       (prop->intr_grp == INTR_GROUP1S));
+
+	blk->intr_mask |= bit;
+
+	if (prop->intr_grp == INTR_GROUP1S) {
+		blk->grpmod |= bit;
+		blk->ctlr_enable |= CTLR_ENABLE_G1S_BIT;
+	} else {
+		blk->grpmod &= ~bit;
+		blk->ctlr_enable |= CTLR_ENABLE_G0_BIT;
+	}
+
+	/* Configurations for SGIs 0-15 are ignored */
+	if (prop->intr_num >= MIN_PPI_ID) {
+		blk->cfg_mask[n >> 4] |= (uint32_t)GIC_CFG_MASK << cfg_shift;
+		blk->cfg[n >> 4] &= ~((uint32_t)GIC_CFG_MASK << cfg_shift);
+		blk->cfg[n >> 4] |= (prop->intr_cfg & GIC_CFG_MASK) << cfg_shift;
+	}
+
+	blk->pri_mask[n >> 2] |= (uint32_t)GIC_PRI_MASK << pri_shift;
+	blk->pri[n >> 2] &= ~((uint32_t)GIC_PRI_MASK << pri_shift);
+	blk->pri[n >> 2] |= (prop->intr_pri & GIC_PRI_MASK) << pri_shift;
+}
+
+/*
+ * Gather the properties of the block of the interrupt at index 'idx' in the
+ * property array, in array order so that the last entry for an interrupt wins.
+ * Return false if this interrupt is not of the requested type, or if its block
+ * was already gathered for a previous entry.
+ */
+static bool gicv3_props_block_get(const interrupt_prop_t *interrupt_props,
+				  unsigned int interrupt_props_num,
+				  unsigned int idx, bool spi,
+				  gicv3_props_block_t *blk)
+{
+	unsigned int intr_num = interrupt_props[idx].intr_num;
+	unsigned int base_id = intr_num & ~((1U << IGROUPR_SHIFT) - 1U);
+	unsigned int i;
+
+	if (!gicv3_props_match(intr_num, spi)) {
+		return false;
+	}
+
+	for (i = 0U; i < idx; i++) {
+		unsigned int id = interrupt_props[i].intr_num;
+
+		if (gicv3_props_match(id, spi) &&
+		    ((id & ~((1U << IGROUPR_SHIFT) - 1U)) == base_id)) {
+			return false;
+		}
+	}
+
+	(void)memset(blk, 0, sizeof(*blk));
+	blk->base_id = base_id;
+
+	for (i = idx; i < interrupt_props_num; i++) {
+		unsigned int id = interrupt_props[i].intr_num;
+
+		if (gicv3_props_match(id, spi) &&
+		    ((id & ~((1U << IGROUPR_SHIFT) - 1U)) == base_id)) {
+			gicv3_props_block_add(blk, &interrupt_props[i]);
+		}
+	}
+
+	return true;
+}
+
+/*
+ * Write the priorities of a block in an IPRIORITYR register, using a single
+ * write when all of its four interrupts are set and byte writes otherwise.
+ */
+static void gicv3_props_write_pri(uintptr_t addr, uint32_t mask, uint32_t val)
+{
+	unsigned int i;
+
+	if (mask == 0U) {
+		return;
+	}
+
+	if (mask == ~0U) {
+		mmio_write_32(addr, val);
+		return;
+	}
+
+	for (i = 0U; i < 4U; i++) {
+		if (((mask >> (i << 3)) & GIC_PRI_MASK) != 0U) {
+			mmio_write_8(addr + i, (uint8_t)(val >> (i << 3)));
+		}
+	}
+}
+
 /*******************************************************************************
  * Helper function to configure properties of secure (E)SPIs
  ******************************************************************************/
@@ -209,8 +340,8 @@ unsigned int gicv3_secure_spis_config_props(uintptr_t gicd_base,
 		const interrupt_prop_t *interrupt_props,
 		unsigned int interrupt_props_num)
 {
-	unsigned int i;
-	const interrupt_prop_t *current_prop;
+	unsigned int i, j;
+	gicv3_props_block_t blk;
 	unsigned long long gic_affinity_val;
 	unsigned int ctlr_enable = 0U;
 
@@ -219,51 +350,57 @@ unsigned int gicv3_secure_spis_config_props(uintptr_t gicd_base,
 		assert(interrupt_props != NULL);
 	}
 
-	for (i = 0U; i < interrupt_props_num; i++) {
-		current_prop = &interrupt_props[i];
+	/* Target (E)SPIs to the primary CPU */
+	gic_affinity_val = gicd_irouter_val_from_mpidr(read_mpidr(), 0U);
 
-		unsigned int intr_num = current_prop->intr_num;
+	for (i = 0U; i < interrupt_props_num; i++) {
 		uintptr_t multichip_gicd_base;
+		unsigned int id;
 
-		/* Skip SGI, (E)PPI and LPI interrupts */
-		if (!IS_SPI(intr_num)) {
+		if (!gicv3_props_block_get(interrupt_props, interrupt_props_num,
+					   i, true, &blk)) {
 			continue;
 		}
 
-		multichip_gicd_base =
-			gicv3_get_multichip_base(intr_num, gicd_base);
-
-		/* Configure this interrupt as a secure interrupt */
-		gicd_clr_igroupr(multichip_gicd_base, intr_num);
-
-		/* Configure this interrupt as G0 or a G1S interrupt */
-		assert((current_prop->intr_grp == INTR_GROUP0) ||
-				(current_prop->intr_grp == INTR_GROUP1S));
-
-		if (current_prop->intr_grp == INTR_GROUP1S) {
-			gicd_set_igrpmodr(multichip_gicd_base, intr_num);
-			ctlr_enable |= CTLR_ENABLE_G1S_BIT;
-		} else {
-			gicd_clr_igrpmodr(multichip_gicd_base, intr_num);
-			ctlr_enable |= CTLR_ENABLE_G0_BIT;
+		id = blk.base_id;
+		multichip_gicd_base = gicv3_get_multichip_base(id, gicd_base);
+
+		/* Configure the interrupts as secure G0 or G1S interrupts */
+		mmio_clrbits_32(multichip_gicd_base + GICD_OFFSET(IGROUP, id),
+				blk.intr_mask);
+		mmio_clrsetbits_32(multichip_gicd_base +
+				   GICD_OFFSET(IGRPMOD, id),
+				   blk.intr_mask, blk.grpmod);
+
+		/* Set interrupt configurations */
+		for (j = 0U; j < ARRAY_SIZE(blk.cfg_mask); j++) {
+			if (blk.cfg_mask[j] != 0U) {
+				mmio_clrsetbits_32(multichip_gicd_base +
+					GICD_OFFSET(ICFG, id + (j << ICFGR_SHIFT)),
+					blk.cfg_mask[j], blk.cfg[j]);
+			}
 		}
 
-		/* Set interrupt configuration */
-		gicd_set_icfgr(multichip_gicd_base, intr_num,
-				current_prop->intr_cfg);
+		/* Set the priorities */
+		for (j = 0U; j < ARRAY_SIZE(blk.pri_mask); j++) {
+			gicv3_props_write_pri(multichip_gicd_base +
+				GICD_OFFSET(IPRIORITY,
+					    id + (j << IPRIORITYR_SHIFT)),
+				blk.pri_mask[j], blk.pri[j]);
+		}
 
-		/* Set the priority of this interrupt */
-		gicd_set_ipriorityr(multichip_gicd_base, intr_num,
-				current_prop->intr_pri);
+		for (j = 0U; j < 32U; j++) {
+			if ((blk.intr_mask & ((uint32_t)1 << j)) != 0U) {
+				gicd_write_irouter(multichip_gicd_base, id + j,
+						   gic_affinity_val);
+			}
+		}
 
-		/* Target (E)SPIs to the primary CPU */
-		gic_affinity_val =
-			gicd_irouter_val_from_mpidr(read_mpidr(), 0U);
-		gicd_write_irouter(multichip_gicd_base, intr_num,
-			gic_affinity_val);
+		/* Enable the interrupts */
+		mmio_write_32(multichip_gicd_base + GICD_OFFSET(ISENABLE, id),
+			      blk.intr_mask);
 
-		/* Enable this interrupt */
-		gicd_set_isenabler(multichip_gicd_base, intr_num);
+		ctlr_enable |= blk.ctlr_enable;
 	}
 
 	return ctlr_enable;
@@ -327,8 +464,8 @@ unsigned int gicv3_secure_ppi_sgi_config_props(uintptr_t gicr_base,
 		const interrupt_prop_t *interrupt_props,
 		unsigned int interrupt_props_num)
 {
-	unsigned int i;
-	const interrupt_prop_t *current_prop;
+	unsigned int i, j;
+	gicv3_props_block_t blk;
 	unsigned int ctlr_enable = 0U;
 
 	/* Make sure there's a valid property array */
@@ -337,45 +474,43 @@ unsigned int gicv3_secure_ppi_sgi_config_props(uintptr_t gicr_base,
 	}
 
 	for (i = 0U; i < interrupt_props_num; i++) {
-		current_prop = &interrupt_props[i];
-
-		unsigned int intr_num = current_prop->intr_num;
+		unsigned int id;
 
-		/* Skip (E)SPI interrupt */
-		if (!IS_SGI_PPI(intr_num)) {
+		if (!gicv3_props_block_get(interrupt_props, interrupt_props_num,
+					   i, false, &blk)) {
 			continue;
 		}
 
-		/* Configure this interrupt as a secure interrupt */
-		gicr_clr_igroupr(gicr_base, intr_num);
+		id = blk.base_id;
 
-		/* Configure this interrupt as G0 or a G1S interrupt */
-		assert((current_prop->intr_grp == INTR_GROUP0) ||
-			(current_prop->intr_grp == INTR_GROUP1S));
+		/* Configure the interrupts as secure G0 or G1S interrupts */
+		mmio_clrbits_32(gicr_base + GICR_OFFSET(IGROUP, id),
+				blk.intr_mask);
+		mmio_clrsetbits_32(gicr_base + GICR_OFFSET(IGRPMOD, id),
+				   blk.intr_mask, blk.grpmod);
 
-		if (current_prop->intr_grp == INTR_GROUP1S) {
-			gicr_set_igrpmodr(gicr_base, intr_num);
-			ctlr_enable |= CTLR_ENABLE_G1S_BIT;
-		} else {
-			gicr_clr_igrpmodr(gicr_base, intr_num);
-			ctlr_enable |= CTLR_ENABLE_G0_BIT;
+		/* Set the priorities */
+		for (j = 0U; j < ARRAY_SIZE(blk.pri_mask); j++) {
+			gicv3_props_write_pri(gicr_base +
+				GICR_OFFSET(IPRIORITY,
+					    id + (j << IPRIORITYR_SHIFT)),
+				blk.pri_mask[j], blk.pri[j]);
 		}
 
-		/* Set the priority of this interrupt */
-		gicr_set_ipriorityr(gicr_base, intr_num,
-					current_prop->intr_pri);
-
-		/*
-		 * Set interrupt configuration for (E)PPIs.
-		 * Configurations for SGIs 0-15 are ignored.
-		 */
-		if (intr_num >= MIN_PPI_ID) {
-			gicr_set_icfgr(gicr_base, intr_num,
-					current_prop->intr_cfg);
+		/* Set interrupt configurations for (E)PPIs */
+		for (j = 0U; j < ARRAY_SIZE(blk.cfg_mask); j++) {
+			if (blk.cfg_mask[j] != 0U) {
+				mmio_clrsetbits_32(gicr_base +
+					GICR_OFFSET(ICFG, id + (j << ICFGR_SHIFT)),
+					blk.cfg_mask[j], blk.cfg[j]);
+			}
 		}
 
-		/* Enable this interrupt */
-		gicr_set_isenabler(gicr_base, intr_num);
+		/* Enable the interrupts */
+		mmio_write_32(gicr_base + GICR_OFFSET(ISENABLE, id),
+			      blk.intr_mask);
+
+		ctlr_enable |= blk.ctlr_enable;
 	}
 
 	return ctlr_enable;
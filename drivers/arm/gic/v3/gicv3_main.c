@@ -13,6 +13,8 @@
 #include <common/interrupt_props.h>
 #include <drivers/arm/gic600_multichip.h>
 #include <drivers/arm/gicv3.h>
+#include <lib/pmf/pmf.h>
+#include <lib/runtime_instr.h>
 #include <lib/spinlock.h>
 #include <plat/common/platform.h>
 
@@ -27,6 +29,23 @@ const gicv3_driver_data_t *gicv3_driver_data;
  */
 static spinlock_t gic_lock;
 
+#if GICV3_RDISTIF_MAP_AT_INIT
+/*
+ * GICR_TYPER of each Redistributor, saved along with its base address when the
+ * Redistributor frames are walked, so that it does not need to be read again.
+ */
+static uint64_t gicr_typer[PLATFORM_CORE_COUNT];
+#define GICR_TYPER_CACHE	gicr_typer
+
+/*
+ * Spinlock serialising the probes of the Redistributor frames, so that no CPU
+ * looks itself up in the map while a set of frames is still being walked.
+ */
+static spinlock_t gicr_map_lock;
+#else
+#define GICR_TYPER_CACHE	NULL
+#endif
+
 /*
  * Redistributor power operations are weakly bound so that they can be
  * overridden
@@ -93,6 +112,14 @@ static bool is_sgi_ppi(unsigned int id);
 #define RESTORE_GICD_EREGS(base, ctx, intr_num, reg, REG)
 #endif /* GIC_EXT_INTID */
 
+/* Time the save and restore of the Distributor */
+#if ENABLE_RUNTIME_INSTRUMENTATION && defined(IMAGE_BL31)
+#define GICD_CAPTURE_TIMESTAMP(tid)	\
+	PMF_CAPTURE_TIMESTAMP(rt_instr_svc, (tid), PMF_NO_CACHE_MAINT)
+#else
+#define GICD_CAPTURE_TIMESTAMP(tid)
+#endif
+
 /*******************************************************************************
  * This function initialises the ARM GICv3 driver in EL3 with provided platform
  * inputs.
@@ -112,6 +139,10 @@ void __init gicv3_driver_init(const gicv3_driver_data_t *plat_driver_data)
 	assert((plat_driver_data->interrupt_props_num != 0U) ?
 	       (plat_driver_data->interrupt_props != NULL) : 1);
 
+#if GICV3_RDISTIF_MAP_AT_INIT
+	assert(plat_driver_data->rdistif_num <= PLATFORM_CORE_COUNT);
+#endif
+
 	/* Check for system register support */
 #ifndef __aarch64__
 	assert((read_id_pfr1() &
@@ -145,6 +176,7 @@ void __init gicv3_driver_init(const gicv3_driver_data_t *plat_driver_data)
 		 * the platform port
 		 */
 		gicv3_rdistif_base_addrs_probe(plat_driver_data->rdistif_base_addrs,
+						   GICR_TYPER_CACHE,
 						   plat_driver_data->rdistif_num,
 						   plat_driver_data->gicr_base,
 						   plat_driver_data->mpidr_to_core_pos);
@@ -155,6 +187,9 @@ void __init gicv3_driver_init(const gicv3_driver_data_t *plat_driver_data)
 		flush_dcache_range((uintptr_t)(plat_driver_data->rdistif_base_addrs),
 			plat_driver_data->rdistif_num *
 			sizeof(*(plat_driver_data->rdistif_base_addrs)));
+#if GICV3_RDISTIF_MAP_AT_INIT
+		flush_dcache_range((uintptr_t)gicr_typer, sizeof(gicr_typer));
+#endif
 #endif
 	}
 	gicv3_driver_data = plat_driver_data;
@@ -549,6 +584,19 @@ void gicv3_its_restore(uintptr_t gits_base,
 	gits_write_ctlr(gits_base, its_ctx->gits_ctlr & ~GITS_CTLR_ENABLED_BIT);
 }
 
+/*
+ * Return the GICR_TYPER of a Redistributor, from the map of the Redistributors
+ * when it is kept.
+ */
+static inline uint64_t gicv3_rdistif_typer(unsigned int proc_num)
+{
+#if GICV3_RDISTIF_MAP_AT_INIT
+	return gicr_typer[proc_num];
+#else
+	return gicr_read_typer(gicv3_driver_data->rdistif_base_addrs[proc_num]);
+#endif
+}
+
 /*****************************************************************************
  * Function to save the GIC Redistributor register context. This function
  * must be invoked after CPU interface disable and prior to Distributor save.
@@ -569,7 +617,7 @@ void gicv3_rdistif_save(unsigned int proc_num,
 
 #if GIC_EXT_INTID
 	/* Calculate number of PPI registers */
-	ppi_regs_num = (unsigned int)((gicr_read_typer(gicr_base) >>
+	ppi_regs_num = (unsigned int)((gicv3_rdistif_typer(proc_num) >>
 			TYPER_PPI_NUM_SHIFT) & TYPER_PPI_NUM_MASK) + 1;
 	/* All other values except PPInum [0-2] are reserved */
 	if (ppi_regs_num > 3U) {
@@ -644,7 +692,7 @@ void gicv3_rdistif_init_restore(unsigned int proc_num,
 
 #if GIC_EXT_INTID
 	/* Calculate number of PPI registers */
-	ppi_regs_num = (unsigned int)((gicr_read_typer(gicr_base) >>
+	ppi_regs_num = (unsigned int)((gicv3_rdistif_typer(proc_num) >>
 			TYPER_PPI_NUM_SHIFT) & TYPER_PPI_NUM_MASK) + 1;
 	/* All other values except PPInum [0-2] are reserved */
 	if (ppi_regs_num > 3U) {
@@ -753,6 +801,8 @@ void gicv3_distif_save(gicv3_dist_ctx_t * const dist_ctx)
 	unsigned int num_eints = gicv3_get_espi_limit(gicd_base);
 #endif
 
+	GICD_CAPTURE_TIMESTAMP(RT_INSTR_ENTER_GICD_SAVE);
+
 	/* Wait for pending write to complete */
 	gicd_wait_for_pending_write(gicd_base);
 
@@ -813,6 +863,8 @@ void gicv3_distif_save(gicv3_dist_ctx_t * const dist_ctx)
 	/* Save GICD_IROUTERE for INTIDs 4096 - 5119 */
 	SAVE_GICD_EREGS(gicd_base, dist_ctx, num_eints, irouter, IROUTE);
 
+	GICD_CAPTURE_TIMESTAMP(RT_INSTR_EXIT_GICD_SAVE);
+
 	/*
 	 * GICD_ITARGETSR<n> and GICD_SPENDSGIR<n> are RAZ/WI when
 	 * GICD_CTLR.ARE_(S|NS) bits are set which is the case for our GICv3
@@ -836,6 +888,8 @@ void gicv3_distif_init_restore(const gicv3_dist_ctx_t * const dist_ctx)
 
 	uintptr_t gicd_base = gicv3_driver_data->gicd_base;
 
+	GICD_CAPTURE_TIMESTAMP(RT_INSTR_ENTER_GICD_RESTORE);
+
 	/*
 	 * Clear the "enable" bits for G0/G1S/G1NS interrupts before configuring
 	 * the ARE_S bit. The Distributor might generate a system error
@@ -916,6 +970,8 @@ void gicv3_distif_init_restore(const gicv3_dist_ctx_t * const dist_ctx)
 	/* Restore the GICD_CTLR */
 	gicd_write_ctlr(gicd_base, dist_ctx->gicd_ctlr);
 	gicd_wait_for_pending_write(gicd_base);
+
+	GICD_CAPTURE_TIMESTAMP(RT_INSTR_EXIT_GICD_RESTORE);
 }
 
 /*******************************************************************************
@@ -1297,6 +1353,46 @@ unsigned int gicv3_set_pmr(unsigned int mask)
 	return old_mask;
 }
 
+#if GICV3_RDISTIF_MAP_AT_INIT
+/*
+ * Look up a CPU in the map of the Redistributor frames walked so far. Return
+ * the index of its Redistributor, or 'rdistif_num' if it is not mapped yet.
+ */
+static unsigned int gicv3_rdistif_map_lookup(u_register_t mpidr)
+{
+	const uintptr_t *base_addrs = gicv3_driver_data->rdistif_base_addrs;
+	unsigned int rdistif_num = gicv3_driver_data->rdistif_num;
+	unsigned int i;
+
+	if (gicv3_driver_data->mpidr_to_core_pos != NULL) {
+		i = gicv3_driver_data->mpidr_to_core_pos(mpidr);
+		return ((i < rdistif_num) && (base_addrs[i] != 0U)) ?
+			i : rdistif_num;
+	}
+
+	for (i = 0U; i < rdistif_num; i++) {
+		if ((base_addrs[i] != 0U) &&
+		    (mpidr_from_gicr_typer(gicr_typer[i]) == mpidr)) {
+			break;
+		}
+	}
+
+	return i;
+}
+
+/* Check whether the Redistributor frames at 'gicr_frame' were walked */
+static bool gicv3_rdistif_frame_mapped(uintptr_t gicr_frame)
+{
+	for (unsigned int i = 0U; i < gicv3_driver_data->rdistif_num; i++) {
+		if (gicv3_driver_data->rdistif_base_addrs[i] == gicr_frame) {
+			return true;
+		}
+	}
+
+	return false;
+}
+#endif /* GICV3_RDISTIF_MAP_AT_INIT */
+
 /*******************************************************************************
  * This function delegates the responsibility of discovering the corresponding
  * Redistributor frames to each CPU itself. It is a modified version of
@@ -1307,11 +1403,14 @@ unsigned int gicv3_set_pmr(unsigned int mask)
  ******************************************************************************/
 int gicv3_rdistif_probe(const uintptr_t gicr_frame)
 {
-	u_register_t mpidr, mpidr_self;
+	u_register_t mpidr_self;
 	unsigned int proc_num;
+#if !GICV3_RDISTIF_MAP_AT_INIT
+	u_register_t mpidr;
 	uint64_t typer_val;
 	uintptr_t rdistif_base;
 	bool gicr_frame_found = false;
+#endif
 
 	assert(gicv3_driver_data->gicr_base == 0U);
 
@@ -1325,6 +1424,38 @@ int gicv3_rdistif_probe(const uintptr_t gicr_frame)
 	}
 
 	mpidr_self = read_mpidr_el1() & MPIDR_AFFINITY_MASK;
+
+#if GICV3_RDISTIF_MAP_AT_INIT
+	/*
+	 * The first probe of a set of Redistributor frames, done by the
+	 * primary CPU during cold boot for the set it belongs to, walks all of
+	 * them once and maps the Redistributors of every CPU. The other probes
+	 * only look the calling CPU up in the map, without any access to the
+	 * GIC. The first entry of the map is written before the walk is over,
+	 * so the whole probe is done under the lock.
+	 */
+	spin_lock(&gicr_map_lock);
+
+	if (!gicv3_rdistif_frame_mapped(gicr_frame)) {
+		gicv3_rdistif_base_addrs_probe(
+			gicv3_driver_data->rdistif_base_addrs, gicr_typer,
+			gicv3_driver_data->rdistif_num, gicr_frame,
+			gicv3_driver_data->mpidr_to_core_pos);
+#if !HW_ASSISTED_COHERENCY
+		flush_dcache_range(
+			(uintptr_t)gicv3_driver_data->rdistif_base_addrs,
+			gicv3_driver_data->rdistif_num *
+			sizeof(*(gicv3_driver_data->rdistif_base_addrs)));
+		flush_dcache_range((uintptr_t)gicr_typer, sizeof(gicr_typer));
+#endif
+	}
+
+	proc_num = gicv3_rdistif_map_lookup(mpidr_self);
+
+	spin_unlock(&gicr_map_lock);
+
+	return (proc_num < gicv3_driver_data->rdistif_num) ? 0 : -1;
+#else
 	rdistif_base = gicr_frame;
 	do {
 		typer_val = gicr_read_typer(rdistif_base);
@@ -1368,6 +1499,7 @@ int gicv3_rdistif_probe(const uintptr_t gicr_frame)
 		sizeof(*(gicv3_driver_data->rdistif_base_addrs)));
 #endif
 	return 0; /* Found matching GICR frame */
+#endif /* GICV3_RDISTIF_MAP_AT_INIT */
 }
 
 /******************************************************************************
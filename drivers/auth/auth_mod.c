@@ -17,6 +17,7 @@
 #include <drivers/auth/crypto_mod.h>
 #include <drivers/auth/img_parser_mod.h>
 #include <drivers/fwu/fwu.h>
+#include <lib/bootmarker_capture.h>
 #include <lib/fconf/fconf_tbbr_getter.h>
 #include <plat/common/platform.h>
 
@@ -468,7 +469,9 @@ int auth_mod_verify_img(unsigned int img_id,
 	img_desc = FCONF_GET_PROPERTY(tbbr, cot, img_id);
 
 	/* Ask the parser to check the image integrity */
+	BOOT_PHASE_START(BOOT_PHASE_IMG_PARSE, img_id);
 	rc = img_parser_check_integrity(img_desc->img_type, img_ptr, img_len);
+	BOOT_PHASE_END(BOOT_PHASE_IMG_PARSE, img_id);
 	if (rc != 0) {
 		VERBOSE("[TBB] %s():%d failed with error code %d.\n",
 			__func__, __LINE__, rc);
@@ -486,12 +489,16 @@ int auth_mod_verify_img(unsigned int img_id,
 			rc = 0;
 			break;
 		case AUTH_METHOD_HASH:
+			BOOT_PHASE_START(BOOT_PHASE_IMG_HASH, img_id);
 			rc = auth_hash(&auth_method->param.hash,
 					img_desc, img_ptr, img_len);
+			BOOT_PHASE_END(BOOT_PHASE_IMG_HASH, img_id);
 			break;
 		case AUTH_METHOD_SIG:
+			BOOT_PHASE_START(BOOT_PHASE_IMG_VERIFY, img_id);
 			rc = auth_signature(&auth_method->param.sig,
 					img_desc, img_ptr, img_len);
+			BOOT_PHASE_END(BOOT_PHASE_IMG_VERIFY, img_id);
 			sig_auth_done = true;
 			break;
 		case AUTH_METHOD_NV_CTR:
@@ -535,9 +542,11 @@ int auth_mod_verify_img(unsigned int img_id,
 			}
 
 			/* Get the parameter from the image parser module */
+			BOOT_PHASE_START(BOOT_PHASE_IMG_PARSE, img_id);
 			rc = img_parser_get_auth_param(img_desc->img_type,
 					img_desc->authenticated_data[i].type_desc,
 					img_ptr, img_len, &param_ptr, &param_len);
+			BOOT_PHASE_END(BOOT_PHASE_IMG_PARSE, img_id);
 			if (rc != 0) {
 				VERBOSE("[TBB] %s():%d failed with error code %d.\n",
 					__func__, __LINE__, rc);
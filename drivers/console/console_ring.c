@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <platform_def.h>
+
+#include <arch_helpers.h>
+#include <drivers/console.h>
+#include <drivers/console_ring.h>
+#include <lib/spinlock.h>
+#include <lib/utils_def.h>
+#include <plat/common/platform.h>
+
+/*******************************************************************************
+ * The console rings live in a Non-secure memory region provided and mapped by
+ * the platform, so that the Normal world can read the firmware log like a
+ * coreboot CBMEM console. The region is split evenly between the CPUs. Each
+ * CPU only appends characters to its own ring, without waiting for any
+ * console. The rings are drained to the registered consoles later on, when
+ * the consoles are flushed or when a CPU is about to idle.
+ ******************************************************************************/
+#if !defined(PLAT_CONSOLE_RING_BASE) || !defined(PLAT_CONSOLE_RING_SIZE)
+#error "ENABLE_CONSOLE_RING requires PLAT_CONSOLE_RING_BASE and PLAT_CONSOLE_RING_SIZE"
+#endif
+
+#define CONSOLE_RING_SIZE	((PLAT_CONSOLE_RING_SIZE / PLATFORM_CORE_COUNT) & \
+				 ~(CACHE_WRITEBACK_GRANULE - 1U))
+#define CONSOLE_RING_BODY_SIZE	(CONSOLE_RING_SIZE - CONSOLE_RING_HDR_SIZE)
+
+CASSERT(CONSOLE_RING_SIZE > CONSOLE_RING_HDR_SIZE,
+	assert_console_ring_too_small);
+CASSERT(CONSOLE_RING_BODY_SIZE <= CONSOLE_RING_CURSOR_MASK,
+	assert_console_ring_too_large);
+CASSERT((PLAT_CONSOLE_RING_BASE & (CACHE_WRITEBACK_GRANULE - 1U)) == 0U,
+	assert_console_ring_base_unaligned);
+
+/*
+ * State of a ring, kept in secure memory as the Normal world may write to the
+ * rings. 'written' is only updated by the CPU owning the ring, and 'drained'
+ * by the CPU holding the drain lock. Character 'n' of the ring is stored at
+ * offset ('start' + 'n') modulo the size of the body.
+ */
+typedef struct console_ring_state {
+	volatile uint64_t written;
+	uint64_t drained;
+	uint32_t start;
+	uint32_t cursor;
+} __aligned(CACHE_WRITEBACK_GRANULE) console_ring_state_t;
+
+static console_ring_state_t ring_state[PLATFORM_CORE_COUNT];
+static bool ring_ready;
+
+/* Serialises the draining of the rings to the consoles */
+static spinlock_t ring_drain_lock;
+/* Index + 1 of the CPU draining the rings, 0 if none */
+static unsigned int ring_drain_owner;
+
+static inline unsigned int ring_my_idx(void)
+{
+#ifdef IMAGE_BL31
+	return plat_my_core_pos();
+#else
+	/* BL2 only runs on the primary CPU */
+	return 0U;
+#endif
+}
+
+static inline console_ring_hdr_t *get_ring(unsigned int cpu_idx)
+{
+	return (console_ring_hdr_t *)(PLAT_CONSOLE_RING_BASE +
+		((uintptr_t)cpu_idx * CONSOLE_RING_SIZE));
+}
+
+/* The rings are only written with the data cache enabled */
+static inline bool ring_dcache_enabled(void)
+{
+	u_register_t sctlr = IS_IN_EL3() ? read_sctlr_el3() : read_sctlr_el1();
+
+	return (sctlr & SCTLR_C_BIT) != 0U;
+}
+
+/*
+ * Initialise the rings of all the CPUs. A ring which already holds a valid
+ * log, left by a previous boot stage, is appended to. This is called by the
+ * primary CPU once the platform memory map is set up.
+ */
+void console_ring_init(void)
+{
+	unsigned int i;
+
+	for (i = 0U; i < PLATFORM_CORE_COUNT; i++) {
+		console_ring_hdr_t *ring = get_ring(i);
+		console_ring_state_t *state = &ring_state[i];
+
+		if ((ring->size != CONSOLE_RING_BODY_SIZE) ||
+		    ((ring->cursor & CONSOLE_RING_CURSOR_MASK) >=
+		     CONSOLE_RING_BODY_SIZE)) {
+			ring->size = CONSOLE_RING_BODY_SIZE;
+			ring->cursor = 0U;
+		}
+
+		state->cursor = ring->cursor;
+		state->start = ring->cursor & CONSOLE_RING_CURSOR_MASK;
+		state->written = 0ULL;
+		state->drained = 0ULL;
+	}
+
+	ring_ready = true;
+}
+
+/*
+ * Append a character to the ring of the current CPU. The character is written
+ * before the count of characters is updated, so that a CPU draining the ring
+ * which observes the new count also observes the character. Return -1 if the
+ * rings cannot be used, in which case the character must be written directly
+ * to the consoles.
+ */
+int console_ring_putc(int c)
+{
+	console_ring_state_t *state;
+	console_ring_hdr_t *ring;
+	uint32_t pos, flags;
+	unsigned int idx;
+
+	if (!ring_ready || !ring_dcache_enabled()) {
+		return -1;
+	}
+
+	idx = ring_my_idx();
+	state = &ring_state[idx];
+	ring = get_ring(idx);
+
+	pos = state->cursor & CONSOLE_RING_CURSOR_MASK;
+	flags = state->cursor & ~CONSOLE_RING_CURSOR_MASK;
+
+	ring->body[pos] = (uint8_t)c;
+
+	pos++;
+	if (pos == CONSOLE_RING_BODY_SIZE) {
+		pos = 0U;
+		flags |= CONSOLE_RING_OVERFLOW;
+	}
+
+	state->cursor = pos | flags;
+	ring->cursor = state->cursor;
+
+	dmbish();
+
+	state->written = state->written + 1ULL;
+
+	return c;
+}
+
+/*
+ * Write the characters of a ring which were not drained yet to the consoles.
+ * Unless 'all' is set, a partial line is left in the ring so that the lines of
+ * different CPUs are not interleaved. Characters overwritten before they could
+ * be drained are lost.
+ */
+static void ring_drain_one(unsigned int cpu_idx, bool all)
+{
+	console_ring_state_t *state = &ring_state[cpu_idx];
+	const console_ring_hdr_t *ring = get_ring(cpu_idx);
+	uint64_t start, end, n;
+
+	end = state->written;
+	dmbish();
+
+	start = state->drained;
+	if ((end - start) > CONSOLE_RING_BODY_SIZE) {
+		start = end - CONSOLE_RING_BODY_SIZE;
+	}
+
+	if (!all) {
+		while ((end > start) &&
+		       (ring->body[(state->start + end - 1U) %
+				   CONSOLE_RING_BODY_SIZE] != '\n')) {
+			end--;
+		}
+	}
+
+	for (n = start; n < end; n++) {
+		(void)console_putc_unbuffered(
+			ring->body[(state->start + n) % CONSOLE_RING_BODY_SIZE]);
+	}
+
+	state->drained = end;
+}
+
+/*
+ * Check whether any ring holds characters which were not drained yet. This is
+ * only a hint, as the rings may be written and drained concurrently.
+ */
+bool console_ring_pending(void)
+{
+	unsigned int i;
+
+	if (!ring_ready) {
+		return false;
+	}
+
+	for (i = 0U; i < PLATFORM_CORE_COUNT; i++) {
+		if (ring_state[i].written != ring_state[i].drained) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/*
+ * Drain the rings of all the CPUs to the consoles. If 'wait' is not set, the
+ * rings are only drained if no other CPU is draining them, and only up to the
+ * last complete line. Otherwise everything is drained, unless this CPU is
+ * already draining the rings, e.g. when panicking from a console driver.
+ */
+void console_ring_drain(bool wait)
+{
+	unsigned int me;
+	unsigned int i;
+
+	if (!ring_ready || !ring_dcache_enabled()) {
+		return;
+	}
+
+	me = ring_my_idx() + 1U;
+
+	if (!spin_trylock(&ring_drain_lock)) {
+		if (!wait || (ring_drain_owner == me)) {
+			return;
+		}
+		spin_lock(&ring_drain_lock);
+	}
+
+	ring_drain_owner = me;
+
+	for (i = 0U; i < PLATFORM_CORE_COUNT; i++) {
+		ring_drain_one(i, wait);
+	}
+
+	ring_drain_owner = 0U;
+
+	spin_unlock(&ring_drain_lock);
+}
@@ -9,6 +9,7 @@
 #include <stdlib.h>
 
 #include <drivers/console.h>
+#include <drivers/console_ring.h>
 
 console_t *console_list;
 static uint8_t console_state = CONSOLE_FLAG_BOOT;
@@ -86,7 +87,11 @@ static int do_putc(int c, console_t *console)
 	return console->putc(c, console);
 }
 
+#if CONSOLE_RING_SUPPORTED
+int console_putc_unbuffered(int c)
+#else
 int console_putc(int c)
+#endif
 {
 	int err = ERROR_NO_VALID_CONSOLE;
 	console_t *console;
@@ -100,6 +105,23 @@ int console_putc(int c)
 	return err;
 }
 
+#if CONSOLE_RING_SUPPORTED
+/*
+ * Characters are appended to the console ring of the current CPU, to be
+ * written to the consoles later on. They are written directly to the consoles
+ * when crashing, or when the rings cannot be used yet.
+ */
+int console_putc(int c)
+{
+	if ((console_state != CONSOLE_FLAG_CRASH) &&
+	    (console_ring_putc(c) >= 0)) {
+		return c;
+	}
+
+	return console_putc_unbuffered(c);
+}
+#endif /* CONSOLE_RING_SUPPORTED */
+
 int putchar(int c)
 {
 	if (console_putc(c) == 0)
@@ -134,6 +156,8 @@ void console_flush(void)
 {
 	console_t *console;
 
+	console_ring_drain(true);
+
 	for (console = console_list; console != NULL; console = console->next)
 		if ((console->flags & console_state) && (console->flush != NULL)) {
 			console->flush(console);
@@ -256,6 +256,10 @@
 #define ID_AA64ISAR0_RNDR_SHIFT	U(60)
 #define ID_AA64ISAR0_RNDR_MASK	ULL(0xf)
 
+#define ID_AA64ISAR0_TLB_SHIFT		U(56)
+#define ID_AA64ISAR0_TLB_MASK		ULL(0xf)
+#define ID_AA64ISAR0_TLB_RANGE		ULL(0x2)
+
 /* ID_AA64ISAR1_EL1 definitions */
 #define ID_AA64ISAR1_EL1		S3_0_C0_C6_1
 
@@ -695,6 +699,7 @@
 #define EVNTDIR_BIT		(U(1) << 3)
 #define EVNTI_SHIFT		U(4)
 #define EVNTI_MASK		U(0xf)
+#define EVNTIS_BIT		(U(1) << 17)
 
 /* CPTR_EL3 definitions */
 #define TCPAC_BIT		(U(1) << 31)
@@ -995,6 +1000,21 @@
 #define TLBI_ADDR_MASK		ULL(0x00000FFFFFFFFFFF)
 #define TLBI_ADDR(x)		(((x) >> TLBI_ADDR_SHIFT) & TLBI_ADDR_MASK)
 
+/*
+ * Fields of the operand of the TLBI range operations (FEAT_TLBIRANGE). A range
+ * operation invalidates (NUM + 1) * 2^(5 * SCALE + 1) pages of the translation
+ * granule TG, starting at BaseADDR, in units of the translation granule.
+ */
+#define TLBIR_TG_SHIFT		U(46)
+#define TLBIR_TG_4K		ULL(1)
+#define TLBIR_TG_16K		ULL(2)
+#define TLBIR_TG_64K		ULL(3)
+#define TLBIR_SCALE_SHIFT	U(44)
+#define TLBIR_SCALE_MAX		U(3)
+#define TLBIR_NUM_SHIFT		U(39)
+#define TLBIR_NUM_MAX		U(31)
+#define TLBIR_BADDR_MASK	ULL(0x1FFFFFFFFF)
+
 /*******************************************************************************
  * Definitions of register offsets and fields in the CNTCTLBase Frame of the
  * system level implementation of the Generic Timer.
@@ -138,6 +138,17 @@ static inline void tlbi ## _type(uint64_t v)			\
 }
 #endif /* ERRATA_A57_813419 */
 
+/*
+ * Define function for a TLBI range operation (FEAT_TLBIRANGE), Inner Shareable.
+ * The operation is encoded as a SYS instruction so that the assembler doesn't
+ * need to support Armv8.4-A.
+ */
+#define DEFINE_TLBIOP_RANGE_PARAM_FUNC(_type, _op1, _op2)		\
+static inline void tlbi ## _type(uint64_t v)				\
+{									\
+	__asm__("sys #" #_op1 ", c8, c2, #" #_op2 ", %0" : : "r" (v));	\
+}
+
 #if ERRATA_A53_819472 || ERRATA_A53_824069 || ERRATA_A53_827319
 /*
  * Define function for DC instruction with register parameter that enables
@@ -199,6 +210,10 @@ DEFINE_SYSOP_TYPE_PARAM_FUNC(tlbi, vae3is)
 DEFINE_SYSOP_TYPE_PARAM_FUNC(tlbi, vale3is)
 #endif
 
+DEFINE_TLBIOP_RANGE_PARAM_FUNC(rvaae1is, 0, 3)
+DEFINE_TLBIOP_RANGE_PARAM_FUNC(rvae2is, 4, 1)
+DEFINE_TLBIOP_RANGE_PARAM_FUNC(rvae3is, 6, 1)
+
 /*******************************************************************************
  * Cache maintenance accessor prototypes
  ******************************************************************************/
@@ -453,6 +468,7 @@ DEFINE_SYSREG_RW_FUNCS(cptr_el3)
 
 DEFINE_SYSREG_RW_FUNCS(cpacr_el1)
 DEFINE_SYSREG_RW_FUNCS(cntfrq_el0)
+DEFINE_SYSREG_RW_FUNCS(cntkctl_el1)
 DEFINE_SYSREG_RW_FUNCS(cnthp_ctl_el2)
 DEFINE_SYSREG_RW_FUNCS(cnthp_tval_el2)
 DEFINE_SYSREG_RW_FUNCS(cnthp_cval_el2)
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef EHF_STATS_H
+#define EHF_STATS_H
+
+#include <lib/utils_def.h>
+
+/*
+ * SiP SMC function IDs used by the Normal world to read and reset the per-CPU
+ * statistics of the EL3 exception handling priority levels.
+ *
+ * x1 --> command, one of EHF_STATS_SMC_GET or EHF_STATS_SMC_RESET.
+ * x2 --> MPIDR of the CPU, for EHF_STATS_SMC_GET.
+ * x3 --> priority level, or EHF_STATS_NS_BLOCKED, for EHF_STATS_SMC_GET.
+ *
+ * On return, x0 holds an error code. For EHF_STATS_SMC_GET, x1 holds the number
+ * of activations of the priority level, x2 the total time it was active and x3
+ * the longest time it was active, in ticks of the system counter.
+ *
+ * An interrupt is accounted from its acknowledgement to the return of the
+ * handler. SDEI events are dispatched synchronously, so for a priority bound
+ * to SDEI this covers the Normal world handler up to sdei_event_complete() and
+ * the EOI. An event dispatched with sdei_dispatch_event() from the handler of
+ * another priority is accounted at both priority levels.
+ */
+#define EHF_STATS_SMC_32		U(0x82000070)
+#define EHF_STATS_SMC_64		U(0xC2000070)
+#define EHF_STATS_NUM_SMC_CALLS		2
+
+#define EHF_STATS_FID_VALUE		U(0x70)
+#define is_ehf_stats_fid(_fid)		\
+	(((_fid) & FUNCID_NUM_MASK) == EHF_STATS_FID_VALUE)
+
+/* Commands of the EHF_STATS SMC */
+#define EHF_STATS_SMC_GET		U(0)
+#define EHF_STATS_SMC_RESET		U(1)
+
+/*
+ * Pseudo priority level designating the windows during which Secure execution
+ * masked Non-secure interrupts, from leaving the Normal world until returning
+ * to it or calling ehf_allow_ns_preemption().
+ */
+#define EHF_STATS_NS_BLOCKED		U(0x100)
+
+/* Error codes of the EHF_STATS SMC */
+#define EHF_STATS_E_SUCCESS		0
+#define EHF_STATS_E_INVALID_PARAMS	-2
+#define EHF_STATS_E_DENIED		-3
+
+#ifndef __ASSEMBLER__
+
+#include <stdint.h>
+
+#if EHF_STATS
+void ehf_stats_init(void);
+uint64_t ehf_stats_begin(void);
+void ehf_stats_end(unsigned int idx, uint64_t start);
+void ehf_stats_activate(unsigned int idx);
+void ehf_stats_deactivate(unsigned int idx);
+void ehf_stats_ns_blocked(void);
+void ehf_stats_ns_unblocked(void);
+
+uintptr_t ehf_stats_smc_handler(unsigned int smc_fid,
+				u_register_t x1,
+				u_register_t x2,
+				u_register_t x3,
+				u_register_t x4,
+				void *cookie,
+				void *handle,
+				u_register_t flags);
+#else
+static inline void ehf_stats_init(void)
+{
+}
+
+static inline uint64_t ehf_stats_begin(void)
+{
+	return 0ULL;
+}
+
+static inline void ehf_stats_end(unsigned int idx, uint64_t start)
+{
+}
+
+static inline void ehf_stats_activate(unsigned int idx)
+{
+}
+
+static inline void ehf_stats_deactivate(unsigned int idx)
+{
+}
+
+static inline void ehf_stats_ns_blocked(void)
+{
+}
+
+static inline void ehf_stats_ns_unblocked(void)
+{
+}
+#endif /* EHF_STATS */
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* EHF_STATS_H */
@@ -32,9 +32,11 @@
 #include <cdefs.h>
 #include <stdarg.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 
 #include <drivers/console.h>
+#include <lib/spinlock.h>
 
 /*
  * Define Log Markers corresponding to each log level which will
@@ -59,8 +61,42 @@
 		}					\
 	} while (false)
 
+/*
+ * When the log rate limiting is enabled, each ERROR and WARN call site of BL31
+ * has its own token bucket, so that a message repeatedly triggered, e.g. by a
+ * misbehaving Normal world, cannot keep the CPUs waiting for the console.
+ */
+#if ENABLE_LOG_RATELIMIT && defined(IMAGE_BL31)
+#define TF_LOG_RATELIMIT_SUPPORTED	1
+#else
+#define TF_LOG_RATELIMIT_SUPPORTED	0
+#endif
+
+#if TF_LOG_RATELIMIT_SUPPORTED
+typedef struct tf_log_ratelimit {
+	spinlock_t lock;
+	/* Number of tokens used since the bucket was last full */
+	unsigned int used;
+	unsigned int suppressed;
+	/* Value of the system counter when a token was last returned */
+	uint64_t last;
+} tf_log_ratelimit_t;
+
+#define tf_log_ratelimited(marker, ...)					\
+	do {								\
+		static tf_log_ratelimit_t tf_log_rl_state;		\
+		if (tf_log_ratelimit(&tf_log_rl_state, marker)) {	\
+			tf_log(marker __VA_ARGS__);			\
+		}							\
+	} while (false)
+#endif /* TF_LOG_RATELIMIT_SUPPORTED */
+
 #if LOG_LEVEL >= LOG_LEVEL_ERROR
-# define ERROR(...)	tf_log(LOG_MARKER_ERROR __VA_ARGS__)
+# if TF_LOG_RATELIMIT_SUPPORTED
+#  define ERROR(...)	tf_log_ratelimited(LOG_MARKER_ERROR, __VA_ARGS__)
+# else
+#  define ERROR(...)	tf_log(LOG_MARKER_ERROR __VA_ARGS__)
+# endif
 # define ERROR_NL()	tf_log_newline(LOG_MARKER_ERROR)
 #else
 # define ERROR(...)	no_tf_log(LOG_MARKER_ERROR __VA_ARGS__)
@@ -74,19 +110,67 @@
 #endif
 
 #if LOG_LEVEL >= LOG_LEVEL_WARNING
-# define WARN(...)	tf_log(LOG_MARKER_WARNING __VA_ARGS__)
+# if TF_LOG_RATELIMIT_SUPPORTED
+#  define WARN(...)	tf_log_ratelimited(LOG_MARKER_WARNING, __VA_ARGS__)
+# else
+#  define WARN(...)	tf_log(LOG_MARKER_WARNING __VA_ARGS__)
+# endif
 #else
 # define WARN(...)	no_tf_log(LOG_MARKER_WARNING __VA_ARGS__)
 #endif
 
+/*
+ * When the binary log is enabled, the INFO and VERBOSE messages of BL31 are not
+ * formatted. The format string is placed in the .tf_log_fmt section, which is
+ * kept in the ELF file but not loaded, and the call site only records the
+ * offset of the format string in that section and the raw arguments. The text
+ * is reconstructed on the host by tools/tf_log_decode. Up to
+ * TF_LOG_BIN_MAX_ARGS arguments are supported.
+ */
+#if ENABLE_BINARY_LOG && defined(IMAGE_BL31)
+#define TF_LOG_BIN_SUPPORTED	1
+#else
+#define TF_LOG_BIN_SUPPORTED	0
+#endif
+
+#if TF_LOG_BIN_SUPPORTED
+#define TF_LOG_BIN_MAX_ARGS	12
+
+#define TF_LOG_BIN_NARGS(...)						\
+	TF_LOG_BIN_NARGS_(0, ##__VA_ARGS__, 12, 11, 10, 9, 8, 7, 6, 5,	\
+			  4, 3, 2, 1, 0)
+#define TF_LOG_BIN_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10,	\
+			  _11, _12, n, ...)	n
+
+#define tf_log_bin_msg(level, marker, fmt, ...)				\
+	do {								\
+		static const char tf_log_fmt_str[] __section(".tf_log_fmt") \
+			= fmt;						\
+		if (false) {						\
+			tf_log(marker fmt, ##__VA_ARGS__);		\
+		}							\
+		tf_log_bin(level, (uintptr_t)tf_log_fmt_str,		\
+			   TF_LOG_BIN_NARGS(__VA_ARGS__), ##__VA_ARGS__);	\
+	} while (false)
+#endif /* TF_LOG_BIN_SUPPORTED */
+
 #if LOG_LEVEL >= LOG_LEVEL_INFO
-# define INFO(...)	tf_log(LOG_MARKER_INFO __VA_ARGS__)
+# if TF_LOG_BIN_SUPPORTED
+#  define INFO(...)	tf_log_bin_msg(LOG_LEVEL_INFO, LOG_MARKER_INFO, __VA_ARGS__)
+# else
+#  define INFO(...)	tf_log(LOG_MARKER_INFO __VA_ARGS__)
+# endif
 #else
 # define INFO(...)	no_tf_log(LOG_MARKER_INFO __VA_ARGS__)
 #endif
 
 #if LOG_LEVEL >= LOG_LEVEL_VERBOSE
-# define VERBOSE(...)	tf_log(LOG_MARKER_VERBOSE __VA_ARGS__)
+# if TF_LOG_BIN_SUPPORTED
+#  define VERBOSE(...)	tf_log_bin_msg(LOG_LEVEL_VERBOSE, LOG_MARKER_VERBOSE, \
+				       __VA_ARGS__)
+# else
+#  define VERBOSE(...)	tf_log(LOG_MARKER_VERBOSE __VA_ARGS__)
+# endif
 #else
 # define VERBOSE(...)	no_tf_log(LOG_MARKER_VERBOSE __VA_ARGS__)
 #endif
@@ -129,7 +213,15 @@ void __dead2 __stack_chk_fail(void);
 
 void tf_log(const char *fmt, ...) __printflike(1, 2);
 void tf_log_newline(const char log_fmt[2]);
+#if TF_LOG_BIN_SUPPORTED
+void tf_log_bin(unsigned int log_level, uintptr_t fmt_id, unsigned int nargs,
+		...);
+#endif
 void tf_log_set_max_level(unsigned int log_level);
+unsigned int tf_log_get_max_level(void);
+#if TF_LOG_RATELIMIT_SUPPORTED
+bool tf_log_ratelimit(tf_log_ratelimit_t *rl, const char log_fmt[2]);
+#endif
 
 #endif /* __ASSEMBLER__ */
 #endif /* DEBUG_H */
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef TF_LOG_SMC_H
+#define TF_LOG_SMC_H
+
+#include <lib/utils_def.h>
+
+/*
+ * SiP SMC function IDs used by the Normal world to read and change the
+ * maximum log level of BL31 at runtime.
+ *
+ * x1 --> command, one of TF_LOG_SMC_GET_LEVEL or TF_LOG_SMC_SET_LEVEL.
+ * x2 --> new log level, for TF_LOG_SMC_SET_LEVEL.
+ *
+ * On return, x0 holds an error code, x1 the current log level and x2 the
+ * maximum log level supported by the build (LOG_LEVEL). The log level can be
+ * set to any LOG_LEVEL_* value lower than or equal to LOG_LEVEL.
+ */
+#define TF_LOG_SMC_32			U(0x82000060)
+#define TF_LOG_SMC_64			U(0xC2000060)
+#define TF_LOG_NUM_SMC_CALLS		2
+
+#define TF_LOG_FID_VALUE		U(0x60)
+#define is_tf_log_fid(_fid)		\
+	(((_fid) & FUNCID_NUM_MASK) == TF_LOG_FID_VALUE)
+
+/* Commands of the TF_LOG SMC */
+#define TF_LOG_SMC_GET_LEVEL		U(0)
+#define TF_LOG_SMC_SET_LEVEL		U(1)
+
+/* Error codes of the TF_LOG SMC */
+#define TF_LOG_E_SUCCESS		0
+#define TF_LOG_E_INVALID_PARAMS		-2
+#define TF_LOG_E_DENIED			-3
+
+#ifndef __ASSEMBLER__
+
+#include <stdint.h>
+
+uintptr_t tf_log_smc_handler(unsigned int smc_fid,
+			     u_register_t x1,
+			     u_register_t x2,
+			     u_register_t x3,
+			     u_register_t x4,
+			     void *cookie,
+			     void *handle,
+			     u_register_t flags);
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* TF_LOG_SMC_H */
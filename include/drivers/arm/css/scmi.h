@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2021, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2023, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -7,6 +7,7 @@
 #ifndef SCMI_H
 #define SCMI_H
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -132,6 +133,15 @@ typedef spinlock_t scmi_lock_t;
 typedef bakery_lock_t scmi_lock_t;
 #endif
 
+/* Maximum number of power up requests queued on an SCMI channel */
+#define SCMI_PWR_STATE_QUEUE_LEN	8U
+
+/* A POWER_STATE_SET request waiting for its SCMI channel to be free */
+typedef struct scmi_pwr_state_req {
+	uint32_t domain_id;
+	uint32_t scmi_pwr_state;
+} scmi_pwr_state_req_t;
+
 /*
  * Structure to represent an SCMI channel.
  */
@@ -141,10 +151,19 @@ typedef struct scmi_channel {
 	scmi_lock_t *lock;
 	/* Indicate whether the channel is initialized */
 	int is_initialized;
+	/*
+	 * Power up requests queued by scmi_pwr_state_set_queued(), and number
+	 * of posted power up requests whose target has not yet called
+	 * scmi_pwr_state_kick(). Protected by the channel lock.
+	 */
+	scmi_pwr_state_req_t queue[SCMI_PWR_STATE_QUEUE_LEN];
+	unsigned int queue_count;
+	unsigned int kick_count;
 } scmi_channel_t;
 
 /* External Common API */
 void *scmi_init(scmi_channel_t *ch);
+bool scmi_channel_is_idle(void *p);
 int scmi_proto_msg_attr(void *p, uint32_t proto_id, uint32_t command_id,
 						uint32_t *attr);
 int scmi_proto_version(void *p, uint32_t proto_id, uint32_t *version);
@@ -154,6 +173,11 @@ int scmi_proto_version(void *p, uint32_t proto_id, uint32_t *version);
  * details on these commands.
  */
 int scmi_pwr_state_set(void *p, uint32_t domain_id, uint32_t scmi_pwr_state);
+int scmi_pwr_state_set_posted(void *p, uint32_t domain_id,
+			      uint32_t scmi_pwr_state);
+int scmi_pwr_state_set_queued(void *p, uint32_t domain_id,
+			      uint32_t scmi_pwr_state);
+void scmi_pwr_state_kick(void *p);
 int scmi_pwr_state_get(void *p, uint32_t domain_id, uint32_t *scmi_pwr_state);
 
 /*
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SCMI_STATS_H
+#define SCMI_STATS_H
+
+#include <lib/utils_def.h>
+
+#ifndef CSS_SCMI_STATS
+#define CSS_SCMI_STATS			0
+#endif
+
+/*
+ * SiP SMC function IDs used by the Normal world to read and reset the per-CPU
+ * statistics of the SCMI commands sent to the SCP.
+ *
+ * x1 --> command, one of SCMI_STATS_SMC_GET or SCMI_STATS_SMC_RESET.
+ * x2 --> MPIDR of the CPU, for SCMI_STATS_SMC_GET.
+ *
+ * On return, x0 holds an error code. For SCMI_STATS_SMC_GET:
+ * x1 --> number of commands for which the response was waited for.
+ * x2 --> total time waiting for these responses.
+ * x3 --> longest time waiting for a response.
+ * x4 --> number of commands posted without waiting for the response.
+ * x5 --> number of times the channel was still busy with a posted command.
+ * x6 --> total time waiting for posted commands to complete.
+ * Times are in ticks of the system counter.
+ */
+#define SCMI_STATS_SMC_32		U(0x82000080)
+#define SCMI_STATS_SMC_64		U(0xC2000080)
+#define SCMI_STATS_NUM_SMC_CALLS	2
+
+#define SCMI_STATS_FID_VALUE		U(0x80)
+#define is_scmi_stats_fid(_fid)		\
+	(((_fid) & FUNCID_NUM_MASK) == SCMI_STATS_FID_VALUE)
+
+/* Commands of the SCMI_STATS SMC */
+#define SCMI_STATS_SMC_GET		U(0)
+#define SCMI_STATS_SMC_RESET		U(1)
+
+/* Error codes of the SCMI_STATS SMC */
+#define SCMI_STATS_E_SUCCESS		0
+#define SCMI_STATS_E_INVALID_PARAMS	-2
+#define SCMI_STATS_E_DENIED		-3
+
+#ifndef __ASSEMBLER__
+
+#include <stdint.h>
+
+#if CSS_SCMI_STATS
+uintptr_t scmi_stats_smc_handler(unsigned int smc_fid,
+				 u_register_t x1,
+				 u_register_t x2,
+				 u_register_t x3,
+				 u_register_t x4,
+				 void *cookie,
+				 void *handle,
+				 u_register_t flags);
+#endif /* CSS_SCMI_STATS */
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* SCMI_STATS_H */
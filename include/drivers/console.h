@@ -83,6 +83,10 @@ void console_set_scope(console_t *console, unsigned int scope);
 void console_switch_state(unsigned int new_state);
 /* Output a character on all consoles registered for the current state. */
 int console_putc(int c);
+#if ENABLE_CONSOLE_RING
+/* Output a character on the consoles, bypassing the console rings. */
+int console_putc_unbuffered(int c);
+#endif
 #if ENABLE_CONSOLE_GETC
 /* Read a character (blocking) from any console registered for current state. */
 int console_getc(void);
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef CONSOLE_RING_H
+#define CONSOLE_RING_H
+
+#include <lib/utils_def.h>
+
+/*
+ * The console rings are only used in BL2 and BL31. The other images keep
+ * writing directly to the consoles.
+ */
+#if ENABLE_CONSOLE_RING && (defined(IMAGE_BL2) || defined(IMAGE_BL31))
+#define CONSOLE_RING_SUPPORTED		1
+#else
+#define CONSOLE_RING_SUPPORTED		0
+#endif
+
+/*
+ * Each ring has the layout of a coreboot CBMEM console: a 32-bit size of the
+ * body, a 32-bit cursor, and the body. The low bits of the cursor hold the
+ * offset of the next character to be written in the body, and its top bit is
+ * set once the ring has wrapped around.
+ */
+#define CONSOLE_RING_HDR_SIZE		U(8)
+#define CONSOLE_RING_CURSOR_MASK	U(0x0fffffff)
+#define CONSOLE_RING_OVERFLOW		(U(1) << 31)
+
+#ifndef __ASSEMBLER__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct console_ring_hdr {
+	uint32_t size;
+	uint32_t cursor;
+	uint8_t body[];
+} console_ring_hdr_t;
+
+#if CONSOLE_RING_SUPPORTED
+void console_ring_init(void);
+int console_ring_putc(int c);
+bool console_ring_pending(void);
+void console_ring_drain(bool wait);
+#else
+static inline void console_ring_init(void)
+{
+}
+
+static inline bool console_ring_pending(void)
+{
+	return false;
+}
+
+static inline void console_ring_drain(bool wait)
+{
+}
+#endif /* CONSOLE_RING_SUPPORTED */
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* CONSOLE_RING_H */
@@ -7,6 +7,8 @@
 #ifndef BOOTMARKER_CAPTURE_H
 #define BOOTMARKER_CAPTURE_H
 
+#include <lib/utils_def.h>
+
 #define BL1_ENTRY	U(0)
 #define BL1_EXIT	U(1)
 #define BL2_ENTRY	U(2)
@@ -15,8 +17,77 @@
 #define BL31_EXIT	U(5)
 #define BL_TOTAL_IDS	U(6)
 
+/*
+ * Fine-grained boot phase identifiers, recorded when
+ * ENABLE_BOOT_PHASE_MARKERS=1. The image phases are recorded against the
+ * image ID being processed, the platform phases against BOOT_PHASE_NO_IMAGE.
+ */
+#define BOOT_PHASE_IMG_OPEN		U(0)
+#define BOOT_PHASE_IMG_READ		U(1)
+#define BOOT_PHASE_IMG_PARSE		U(2)
+#define BOOT_PHASE_IMG_VERIFY		U(3)
+#define BOOT_PHASE_IMG_HASH		U(4)
+#define BOOT_PHASE_IMG_MEASURE		U(5)
+#define BOOT_PHASE_IMG_DECOMPRESS	U(6)
+#define BOOT_PHASE_CONSOLE_INIT		U(7)
+#define BOOT_PHASE_XLAT_INIT		U(8)
+#define BOOT_PHASE_GIC_INIT		U(9)
+#define BOOT_PHASE_PSCI_SETUP		U(10)
+#define BOOT_PHASE_PLAT_SETUP		U(11)
+#define BOOT_PHASE_TOTAL_IDS		U(12)
+
+#define BOOT_PHASE_NO_IMAGE		U(0xFFFFFFFF)
+
 #ifdef __ASSEMBLER__
 PMF_DECLARE_CAPTURE_TIMESTAMP(bl_svc)
+#else
+
+#include <stdint.h>
+
+/*
+ * A single boot phase record. 'start' and 'end' are raw counter values as
+ * returned by read_cntpct_el0().
+ */
+typedef struct boot_phase_rec {
+	uint32_t phase;
+	uint32_t image_id;
+	uint64_t start;
+	uint64_t end;
+} boot_phase_rec_t;
+
+/*
+ * Header of the boot phase log. When the platform provides a persistent
+ * buffer through PLAT_BOOTMARKER_LOG_BASE, the log is handed over from one
+ * boot stage to the next and the header is used to validate it.
+ */
+typedef struct boot_phase_log {
+	uint32_t magic;
+	uint32_t max_recs;
+	uint32_t num_recs;
+	uint32_t dropped;
+	boot_phase_rec_t recs[];
+} boot_phase_log_t;
+
+#define BOOT_PHASE_LOG_MAGIC	U(0x54485042)	/* "BPHT" */
+
+#if ENABLE_BOOT_PHASE_MARKERS
+void bootmarker_phase_start(unsigned int phase, unsigned int image_id);
+void bootmarker_phase_end(unsigned int phase, unsigned int image_id);
+void bootmarker_dump(void);
+
+#define BOOT_PHASE_START(_phase, _image_id)	\
+	bootmarker_phase_start((_phase), (_image_id))
+#define BOOT_PHASE_END(_phase, _image_id)	\
+	bootmarker_phase_end((_phase), (_image_id))
+#else
+static inline void bootmarker_dump(void)
+{
+}
+
+#define BOOT_PHASE_START(_phase, _image_id)
+#define BOOT_PHASE_END(_phase, _image_id)
+#endif /* ENABLE_BOOT_PHASE_MARKERS */
+
 #endif  /*__ASSEMBLER__*/
 
 #endif  /*BOOTMARKER_CAPTURE_H*/
@@ -453,7 +453,14 @@ typedef struct cpu_context {
 #if CTX_INCLUDE_PAUTH_REGS
 	pauth_t pauth_ctx;
 #endif
-} cpu_context_t;
+} __aligned(CACHE_WRITEBACK_GRANULE) cpu_context_t;
+
+/*
+ * The contexts are saved and restored on every entry into and exit from EL3,
+ * so the contexts of different CPUs must not share a cache line.
+ */
+CASSERT((sizeof(cpu_context_t) % CACHE_WRITEBACK_GRANULE) == 0U,
+	assert_cpu_context_not_cache_line_padded);
 
 /*
  * Per-World Context.
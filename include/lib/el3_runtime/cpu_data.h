@@ -139,7 +139,15 @@ typedef struct cpu_data {
 #endif
 } __aligned(CACHE_WRITEBACK_GRANULE) cpu_data_t;
 
+#if PER_CHIP_CPU_DATA
+/*
+ * Location of the cpu_data structure of each CPU, provided by the platform so
+ * that it can be placed in memory local to the chip the CPU belongs to.
+ */
+extern cpu_data_t *const plat_percpu_data_ptrs[PLATFORM_CORE_COUNT];
+#else
 extern cpu_data_t percpu_data[PLATFORM_CORE_COUNT];
+#endif
 
 #ifdef __aarch64__
 CASSERT(CPU_DATA_CONTEXT_NUM == CPU_CONTEXT_NUM,
@@ -162,6 +170,10 @@ CASSERT(CPU_DATA_CRASH_BUF_OFFSET == __builtin_offsetof
 CASSERT(CPU_DATA_SIZE == sizeof(cpu_data_t),
 		assert_cpu_data_size_mismatch);
 
+/* Ensure that no two CPUs share a cache line of their cpu_data */
+CASSERT((sizeof(cpu_data_t) % CACHE_WRITEBACK_GRANULE) == 0U,
+		assert_cpu_data_not_cache_line_padded);
+
 CASSERT(CPU_DATA_CPU_OPS_PTR == __builtin_offsetof
 		(cpu_data_t, cpu_ops_ptr),
 		assert_cpu_data_cpu_ops_ptr_offset_mismatch);
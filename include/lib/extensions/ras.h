@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2018-2023, Arm Limited and Contributors. All rights reserved.
  * Copyright (c) 2020, NVIDIA Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -198,6 +198,11 @@ int ras_ea_handler(unsigned int ea_reason, uint64_t syndrome, void *cookie,
 		void *handle, uint64_t flags);
 void ras_init(void);
 
+#if RAS_CE_BATCHING
+void ras_batch_collect(void);
+void ras_batch_report(uint32_t flags);
+#endif
+
 #endif /* __ASSEMBLER__ */
 
 #endif /* RAS_H */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2018-2023, Arm Limited and Contributors. All rights reserved.
  * Copyright (c) 2020, NVIDIA Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -205,6 +205,12 @@ static inline uint64_t ser_get_control(uintptr_t base, unsigned int idx)
 	return mmio_read_64(base + ERR_CTLR(idx));
 }
 
+static inline void ser_set_control(uintptr_t base, unsigned int idx,
+		uint64_t ctlr)
+{
+	mmio_write_64(base + ERR_CTLR(idx), ctlr);
+}
+
 static inline uint64_t ser_get_status(uintptr_t base, unsigned int idx)
 {
 	return mmio_read_64(base + ERR_STATUS(idx));
@@ -260,6 +266,17 @@ static inline void ser_sys_select_record(unsigned int idx)
 /* Library functions to probe Standard Error Record */
 int ser_probe_memmap(uintptr_t base, unsigned int size_num_k, int *probe_data);
 int ser_probe_sysreg(unsigned int idx_start, unsigned int num_idx, int *probe_data);
+
+/*
+ * Library functions to scan Standard Error Records for all the errors they
+ * hold. The callback is called with the index of each record in error.
+ */
+typedef void (*ser_scan_cb_t)(unsigned int idx, void *arg);
+
+unsigned int ser_scan_memmap(uintptr_t base, unsigned int size_num_k,
+		ser_scan_cb_t cb, void *arg);
+unsigned int ser_scan_sysreg(unsigned int idx_start, unsigned int num_idx,
+		ser_scan_cb_t cb, void *arg);
 #endif /* __ASSEMBLER__ */
 
 #endif /* RAS_ARCH_H */
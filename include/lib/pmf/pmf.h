@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2020, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2023, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -27,6 +27,11 @@
  */
 #define PMF_STORE_ENABLE	(1 << 0)
 #define PMF_DUMP_ENABLE		(1 << 1)
+#if ENABLE_PMF_TRACE
+#define PMF_TRACE_ENABLE	(1 << 2)
+#else
+#define PMF_TRACE_ENABLE	0
+#endif
 
 /*
  * Flags passed to PMF_GET_TIMESTAMP_XXX
@@ -40,7 +45,13 @@
  */
 #define PMF_SMC_GET_TIMESTAMP_32	U(0x82000010)
 #define PMF_SMC_GET_TIMESTAMP_64	U(0xC2000010)
+#if ENABLE_PMF_TRACE
+#define PMF_SMC_GET_TRACE_INFO_32	U(0x82000011)
+#define PMF_SMC_GET_TRACE_INFO_64	U(0xC2000011)
+#define PMF_NUM_SMC_CALLS		4
+#else
 #define PMF_NUM_SMC_CALLS		2
+#endif
 
 /*
  * The macros below are used to identify
@@ -53,6 +64,51 @@
 /* Following are the supported PMF service IDs */
 #define PMF_PSCI_STAT_SVC_ID	0
 #define PMF_RT_INSTR_SVC_ID	1
+#define PMF_BOOT_PHASE_SVC_ID	2
+#define PMF_TRACE_SVC_ID	3
+
+/* Following are the events of the PMF trace service */
+#define PMF_TRACE_WORLD_SWITCH	U(0)
+#define PMF_TRACE_EL3_INTR	U(1)
+#define PMF_TRACE_EHF_MAX	U(2)
+#define PMF_TRACE_TOTAL_IDS	U(3)
+
+/*
+ * Builds the identifier of a PMF trace record from a service ID and a
+ * time-stamp ID within this service.
+ */
+#define PMF_TRACE_ID(_svcid, _tid)	\
+	((((_svcid) << PMF_SVC_ID_SHIFT) & PMF_SVC_ID_MASK) |	\
+	 (((_tid) << PMF_TID_SHIFT) & PMF_TID_MASK))
+
+/*
+ * Layout of the per-CPU PMF trace rings. The header of each ring is alone in
+ * its cache line and is followed by `num_recs` records. `head` is the number of
+ * records written to the ring since it was initialised: the latest record is at
+ * index `(head - 1) % num_recs`. Each ring has a single writer, the CPU which
+ * owns it, which updates `head` after the record is written.
+ */
+#define PMF_TRACE_RING_MAGIC	U(0x52544d50)	/* "PMTR" */
+
+typedef struct pmf_trace_rec {
+	unsigned long long ts;
+	uint32_t id;
+	uint32_t arg;
+} pmf_trace_rec_t;
+
+typedef struct pmf_trace_ring {
+	uint32_t magic;
+	uint32_t num_recs;
+	unsigned long long head;
+} pmf_trace_ring_t;
+
+#if ENABLE_PMF_TRACE && defined(IMAGE_BL31)
+#define PMF_TRACE_EVENT(_tid, _arg)				\
+	__pmf_trace_record(PMF_TRACE_ID(PMF_TRACE_SVC_ID, (_tid)),	\
+			   read_cntpct_el0(), (_arg), PMF_NO_CACHE_MAINT)
+#else
+#define PMF_TRACE_EVENT(_tid, _arg)
+#endif
 
 /*******************************************************************************
  * Function & variable prototypes
@@ -63,6 +119,10 @@ int pmf_get_timestamp_smc(unsigned int tid,
 		unsigned int flags,
 		unsigned long long *ts_value);
 int pmf_setup(void);
+#if ENABLE_PMF_TRACE
+int pmf_trace_setup(void);
+void pmf_trace_get_info(uintptr_t *base, size_t *size, size_t *ring_size);
+#endif
 uintptr_t pmf_smc_handler(unsigned int smc_fid,
 		u_register_t x1,
 		u_register_t x2,
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2020, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2023, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -109,7 +109,7 @@ typedef struct pmf_svc_desc {
  */
 #define PMF_REGISTER_SERVICE(_name, _svcid, _totalid, _flags)	\
 	PMF_ALLOCATE_TIMESTAMP_MEMORY(_name, _totalid)		\
-	PMF_DEFINE_CAPTURE_TIMESTAMP(_name, _flags)		\
+	PMF_DEFINE_CAPTURE_TIMESTAMP(_name, _svcid, _flags)	\
 	PMF_DEFINE_GET_TIMESTAMP(_name)
 
 /*
@@ -168,12 +168,12 @@ typedef struct pmf_svc_desc {
  *
  * The extern declaration is there to satisfy MISRA C-2012 rule 8.4.
  */
-#define PMF_DEFINE_CAPTURE_TIMESTAMP(_name, _flags)			\
+#define PMF_DEFINE_CAPTURE_TIMESTAMP(_name, _svcid, _flags)		\
 	void pmf_capture_timestamp_ ## _name(				\
 			unsigned int tid,				\
 			unsigned long long ts)				\
 	{								\
-		CASSERT(_flags != 0, select_proper_config);		\
+		CASSERT((_flags) != 0, select_proper_config);		\
 		PMF_VALIDATE_TID(_name, (uint64_t)tid);			\
 		uintptr_t base_addr = (uintptr_t) pmf_ts_mem_ ## _name;	\
 		if (((_flags) & PMF_STORE_ENABLE) != 0)			\
@@ -181,12 +181,15 @@ typedef struct pmf_svc_desc {
 				(uint64_t)tid, ts);			\
 		if (((_flags) & PMF_DUMP_ENABLE) != 0)			\
 			__pmf_dump_timestamp((uint64_t)tid, ts);	\
+		if (((_flags) & PMF_TRACE_ENABLE) != 0)			\
+			__pmf_trace_record(PMF_TRACE_ID((_svcid), tid),	\
+				ts, 0U, PMF_NO_CACHE_MAINT);		\
 	}								\
 	void pmf_capture_timestamp_with_cache_maint_ ## _name(		\
 			unsigned int tid,				\
 			unsigned long long ts)				\
 	{								\
-		CASSERT(_flags != 0, select_proper_config);		\
+		CASSERT((_flags) != 0, select_proper_config);		\
 		PMF_VALIDATE_TID(_name, (uint64_t)tid);			\
 		uintptr_t base_addr = (uintptr_t) pmf_ts_mem_ ## _name;	\
 		if (((_flags) & PMF_STORE_ENABLE) != 0)			\
@@ -194,6 +197,9 @@ typedef struct pmf_svc_desc {
 				base_addr, (uint64_t)tid, ts);		\
 		if (((_flags) & PMF_DUMP_ENABLE) != 0)			\
 			__pmf_dump_timestamp((uint64_t)tid, ts);	\
+		if (((_flags) & PMF_TRACE_ENABLE) != 0)			\
+			__pmf_trace_record(PMF_TRACE_ID((_svcid), tid),	\
+				ts, 0U, PMF_CACHE_MAINT);		\
 	}
 
 /*
@@ -253,4 +259,8 @@ unsigned long long __pmf_get_timestamp(uintptr_t base_addr,
 		unsigned int tid,
 		unsigned int cpuid,
 		unsigned int flags);
+void __pmf_trace_record(unsigned int id,
+		unsigned long long ts,
+		uint32_t arg,
+		unsigned int flags);
 #endif /* PMF_HELPERS_H */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2019, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2023, Arm Limited and Contributors. All rights reserved.
  * Copyright (c) 2023, NVIDIA Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -308,8 +308,30 @@ typedef struct psci_cpu_data {
 
 	/* The local power state of this CPU */
 	plat_local_state_t local_state;
+
+#if PSCI_EARLY_CPU_INIT || PSCI_CPU_OFF_TO_PEN
+	/* State of this CPU with respect to the EL3 holding pen */
+	uint8_t pen_state;
+#endif
 } psci_cpu_data_t;
 
+#if PSCI_IDLE_GOVERNOR
+/*******************************************************************************
+ * Structure used by the platform to describe the cost of a local power state
+ * to the PSCI idle governor. All the values are in microseconds.
+ ******************************************************************************/
+typedef struct psci_idle_state_params {
+	/* Time taken to enter the state */
+	uint32_t entry_latency_us;
+
+	/* Time taken to exit the state */
+	uint32_t exit_latency_us;
+
+	/* Minimum residency for the state to save energy */
+	uint32_t target_residency_us;
+} psci_idle_state_params_t;
+#endif
+
 /*******************************************************************************
  * Structure populated by platform specific code to export routines which
  * perform common low level power management functions
@@ -351,6 +373,11 @@ typedef struct plat_psci_ops {
 	int (*write_mem_protect)(int val);
 	int (*system_reset2)(int is_vendor,
 				int reset_type, u_register_t cookie);
+#if PSCI_IDLE_GOVERNOR
+	int (*get_idle_state_params)(unsigned int pwrlvl,
+				plat_local_state_t pwr_domain_state,
+				psci_idle_state_params_t *params);
+#endif
 } plat_psci_ops_t;
 
 /*******************************************************************************
@@ -377,6 +404,9 @@ int psci_features(unsigned int psci_fid);
 int psci_set_suspend_mode(unsigned int mode);
 #endif
 void __dead2 psci_power_down_wfi(void);
+#if PSCI_CPU_OFF_TO_PEN
+void __dead2 psci_pen_park(void);
+#endif
 void psci_arch_setup(void);
 
 #endif /*__ASSEMBLER__*/
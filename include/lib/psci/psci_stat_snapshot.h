@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PSCI_STAT_SNAPSHOT_H
+#define PSCI_STAT_SNAPSHOT_H
+
+#include <lib/utils_def.h>
+
+/*
+ * SiP SMC function IDs used to copy the residency, count and idle governor
+ * demotion statistics of all the power domains into a Non-secure buffer in
+ * one call.
+ *
+ * x1 --> physical address of the Non-secure buffer.
+ * x2 --> size of the Non-secure buffer, in bytes.
+ *
+ * On return, x0 holds an error code and x1 the size of the snapshot. If the
+ * buffer is too small, PSCI_E_INVALID_PARAMS is returned along with the size
+ * required.
+ */
+#define PSCI_STAT_SNAPSHOT_SMC_32	U(0x82000040)
+#define PSCI_STAT_SNAPSHOT_SMC_64	U(0xC2000040)
+#define PSCI_STAT_SNAPSHOT_NUM_SMC_CALLS	2
+
+#define PSCI_STAT_SNAPSHOT_FID_VALUE	U(0x40)
+#define is_psci_stat_snapshot_fid(_fid)	\
+	(((_fid) & FUNCID_NUM_MASK) == PSCI_STAT_SNAPSHOT_FID_VALUE)
+
+#define PSCI_STAT_SNAPSHOT_VERSION	U(1)
+
+#ifndef __ASSEMBLER__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Layout of a snapshot. The header is followed by `num_pwr_domains` records of
+ * `rec_size` bytes, CPU power domains first, in core position order, and then
+ * the non CPU power domains, in the order of the PSCI topology. Each record is
+ * made of a psci_stat_snapshot_pd_t followed by `num_states` entries. The
+ * residencies are in microseconds.
+ */
+typedef struct psci_stat_snapshot_hdr {
+	uint32_t version;
+	uint32_t num_pwr_domains;
+	uint32_t num_states;
+	uint32_t rec_size;
+	/* Value of the system counter when the snapshot was taken */
+	uint64_t timestamp;
+} psci_stat_snapshot_hdr_t;
+
+typedef struct psci_stat_snapshot_pd {
+	uint32_t pwr_lvl;
+	/* Core position of the first CPU in the power domain */
+	uint32_t cpu_start_idx;
+	uint32_t ncpus;
+	uint32_t reserved;
+} psci_stat_snapshot_pd_t;
+
+typedef struct psci_stat_snapshot_entry {
+	uint64_t residency;
+	uint64_t count;
+	/*
+	 * Number of times the idle governor kept the power domain running
+	 * instead of entering this state. Always 0 for CPU power domains and
+	 * when PSCI_IDLE_GOVERNOR is disabled.
+	 */
+	uint64_t demotions;
+} psci_stat_snapshot_entry_t;
+
+size_t psci_stat_snapshot_size(void);
+int psci_stat_snapshot(void *buf, size_t size);
+
+uintptr_t psci_stat_snapshot_smc_handler(unsigned int smc_fid,
+					 u_register_t x1,
+					 u_register_t x2,
+					 u_register_t x3,
+					 u_register_t x4,
+					 void *cookie,
+					 void *handle,
+					 u_register_t flags);
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* PSCI_STAT_SNAPSHOT_H */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2018, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2023, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -15,7 +15,15 @@
 #define RT_INSTR_EXIT_HW_LOW_PWR	U(3)
 #define RT_INSTR_ENTER_CFLUSH		U(4)
 #define RT_INSTR_EXIT_CFLUSH		U(5)
-#define RT_INSTR_TOTAL_IDS		U(6)
+#define RT_INSTR_ENTER_CPU_ON		U(6)
+#define RT_INSTR_EXIT_CPU_ON		U(7)
+#define RT_INSTR_ENTER_GICD_SAVE	U(8)
+#define RT_INSTR_EXIT_GICD_SAVE		U(9)
+#define RT_INSTR_ENTER_GICD_RESTORE	U(10)
+#define RT_INSTR_EXIT_GICD_RESTORE	U(11)
+#define RT_INSTR_ENTER_SDEI_DISPATCH	U(12)
+#define RT_INSTR_EXIT_SDEI_DISPATCH	U(13)
+#define RT_INSTR_TOTAL_IDS		U(14)
 
 #ifndef __ASSEMBLER__
 PMF_DECLARE_CAPTURE_TIMESTAMP(rt_instr_svc)
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2021, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2023, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -147,6 +147,51 @@ typedef struct mmap_region {
 	size_t			granularity;
 } mmap_region_t;
 
+/*
+ * Structure for specifying a region of memory by its limits, for the
+ * translation tables generated at build time with XLAT_TABLES_PREBUILT. The
+ * limits can be linker symbols, such as the ones of the sections of the image,
+ * which can't be used to compute the size of an mmap_region_t in a static
+ * initializer. The end address is exclusive and is rounded up to the next page
+ * boundary.
+ */
+typedef struct xlat_prebuilt_region {
+	unsigned long long	base_pa;
+	uintptr_t		base_va;
+	uintptr_t		end_va;
+	unsigned int		attr;
+	size_t			granularity;
+} xlat_prebuilt_region_t;
+
+/* Helper macro to define an xlat_prebuilt_region_t with an identity mapping. */
+#define XLAT_PREBUILT_REGION_FLAT(_base, _end, _attr)			\
+	{								\
+		.base_pa = (uintptr_t)(_base),				\
+		.base_va = (uintptr_t)(_base),				\
+		.end_va = (uintptr_t)(_end),				\
+		.attr = (_attr),					\
+		.granularity = REGION_DEFAULT_GRANULARITY,		\
+	}
+
+/*
+ * Memory map of a BL image built with XLAT_TABLES_PREBUILT, as passed to
+ * mmap_add() by the image before it initialises the translation tables. Both
+ * arrays are terminated by an entry with a null granularity. The platform
+ * defines it with XLAT_PREBUILT_MMAP() and the tables are generated for these
+ * regions when the image is linked. If the regions added at runtime don't match
+ * them, the tables are built at runtime instead.
+ */
+typedef struct xlat_prebuilt_mmap {
+	const xlat_prebuilt_region_t	*bl_regions;
+	const mmap_region_t		*plat_regions;
+} xlat_prebuilt_mmap_t;
+
+#define XLAT_PREBUILT_MMAP(_bl_regions, _plat_regions)			\
+	const xlat_prebuilt_mmap_t xlat_prebuilt_mmap __used = {	\
+		.bl_regions = (_bl_regions),				\
+		.plat_regions = (_plat_regions),			\
+	}
+
 /*
  * Translation regimes supported by this library. EL_REGIME_INVALID tells the
  * library to detect it at runtime.
@@ -409,6 +409,46 @@ MEASURED_BOOT
 						MT_MEMORY | MT_RW | EL3_PAS)
 #endif
 
+/*
+ * Same regions as ARM_MAP_BL_RO, ARM_MAP_BL_COHERENT_RAM and the ROMLIB ones,
+ * for the translation tables generated at build time. The limits of the image
+ * are given as linker symbols.
+ */
+#if XLAT_TABLES_PREBUILT
+#if SEPARATE_CODE_AND_RODATA
+#define ARM_PREBUILT_BL_RO		XLAT_PREBUILT_REGION_FLAT(		\
+						__TEXT_START__,			\
+						__TEXT_END__,			\
+						MT_CODE | EL3_PAS),		\
+					XLAT_PREBUILT_REGION_FLAT(		\
+						__RODATA_START__,		\
+						__RODATA_END__,			\
+						MT_RO_DATA | EL3_PAS)
+#else
+#define ARM_PREBUILT_BL_RO		XLAT_PREBUILT_REGION_FLAT(		\
+						__RO_START__,			\
+						__RO_END__,			\
+						MT_CODE | EL3_PAS)
+#endif
+#if USE_COHERENT_MEM
+#define ARM_PREBUILT_BL_COHERENT_RAM	XLAT_PREBUILT_REGION_FLAT(		\
+						__COHERENT_RAM_START__,		\
+						__COHERENT_RAM_END__,		\
+						MT_DEVICE | MT_RW | EL3_PAS)
+#endif
+#if USE_ROMLIB
+#define ARM_PREBUILT_ROMLIB_CODE	XLAT_PREBUILT_REGION_FLAT(		\
+						ROMLIB_RO_BASE,			\
+						ROMLIB_RO_LIMIT,		\
+						MT_CODE | EL3_PAS)
+
+#define ARM_PREBUILT_ROMLIB_DATA	XLAT_PREBUILT_REGION_FLAT(		\
+						ROMLIB_RW_BASE,			\
+						ROMLIB_RW_END,			\
+						MT_MEMORY | MT_RW | EL3_PAS)
+#endif
+#endif /* XLAT_TABLES_PREBUILT */
+
 /*
  * Map mem_protect flash region with read and write permissions
  */
@@ -25,12 +25,24 @@
 /* DEBUGFS_SMC_32			0x82000030U */
 /* DEBUGFS_SMC_64			0xC2000030U */
 
+/* PSCI_STAT_SNAPSHOT_SMC_32		0x82000040U */
+/* PSCI_STAT_SNAPSHOT_SMC_64		0xC2000040U */
+
 /*
  * Arm(R) Ethos(TM)-N NPU SiP SMC function IDs
  * 0xC2000050-0xC200005F
  * 0x82000050-0x8200005F
  */
 
+/* TF_LOG_SMC_32			0x82000060U */
+/* TF_LOG_SMC_64			0xC2000060U */
+
+/* EHF_STATS_SMC_32			0x82000070U */
+/* EHF_STATS_SMC_64			0xC2000070U */
+
+/* SCMI_STATS_SMC_32			0x82000080U */
+/* SCMI_STATS_SMC_64			0xC2000080U */
+
 /* ARM SiP Service Calls version numbers */
 #define ARM_SIP_SVC_VERSION_MAJOR		U(0x0)
 #define ARM_SIP_SVC_VERSION_MINOR		U(0x2)
@@ -202,6 +202,11 @@ int plat_sdei_validate_entry_point(uintptr_t ep, unsigned int client_mode);
 void plat_sdei_handle_masked_trigger(uint64_t mpidr, unsigned int intr);
 #endif
 
+/* RAS platform functions */
+#if RAS_CE_BATCHING
+void plat_ras_poll_timer_arm(unsigned int delay_ms);
+#endif
+
 void plat_default_ea_handler(unsigned int ea_reason, uint64_t syndrome, void *cookie,
 		void *handle, uint64_t flags);
 void plat_ea_handler(unsigned int ea_reason, uint64_t syndrome, void *cookie,
@@ -343,6 +348,13 @@ plat_local_state_t plat_get_target_pwr_state(unsigned int lvl,
 			const plat_local_state_t *states,
 			unsigned int ncpu);
 
+/*******************************************************************************
+ * Optional PSCI functions when PSCI_EARLY_CPU_INIT=1 (BL31)
+ ******************************************************************************/
+#if PSCI_EARLY_CPU_INIT
+u_register_t plat_core_pos_to_mpidr(unsigned int core_pos);
+#endif
+
 /*******************************************************************************
  * Mandatory BL31 functions when ENABLE_RME=1
  ******************************************************************************/
@@ -32,6 +32,7 @@
 #include <lib/extensions/sys_reg_trace.h>
 #include <lib/extensions/trbe.h>
 #include <lib/extensions/trf.h>
+#include <lib/pmf/pmf.h>
 #include <lib/utils.h>
 
 #if ENABLE_FEAT_TWED
@@ -1527,5 +1528,7 @@ void cm_set_next_eret_context(uint32_t security_state)
 	ctx = cm_get_context(security_state);
 	assert(ctx != NULL);
 
+	PMF_TRACE_EVENT(PMF_TRACE_WORLD_SWITCH, security_state);
+
 	cm_set_next_context(ctx);
 }
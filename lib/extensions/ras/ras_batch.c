@@ -0,0 +1,483 @@
+/*
+ * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <platform_def.h>
+
+#include <arch_helpers.h>
+#include <bl31/interrupt_mgmt.h>
+#include <common/debug.h>
+#include <lib/el3_runtime/context_mgmt.h>
+#include <lib/extensions/ras.h>
+#include <lib/extensions/ras_arch.h>
+#include <lib/spinlock.h>
+#include <lib/utils.h>
+#include <lib/utils_def.h>
+#include <plat/common/platform.h>
+#include <services/sdei.h>
+#include <tools_share/uuid.h>
+
+/*******************************************************************************
+ * Firmware-first handling of corrected RAS errors in batches. Every RAS
+ * interrupt scans all the error record groups of the platform, reading only
+ * the records flagged by the group status registers of memory-mapped nodes.
+ * The corrected errors found are cleared and staged, and then published at
+ * once to the Normal world as a CPER Generic Error Status Block in a platform
+ * provided Non-secure buffer, followed by a single SDEI event. Uncorrected and
+ * deferred errors are left in their records for the handler of their group.
+ *
+ * When corrected errors arrive faster than PLAT_RAS_CE_STORM_THRESHOLD per
+ * PLAT_RAS_CE_STORM_WINDOW_MS, the corrected error interrupts of the records
+ * reporting them are disabled and the records are polled every
+ * PLAT_RAS_POLL_PERIOD_MS instead, using a timer interrupt provided by the
+ * platform and registered as a RAS interrupt, until the rate drops again.
+ ******************************************************************************/
+#if !defined(PLAT_RAS_CPER_BASE) || !defined(PLAT_RAS_CPER_SIZE) || \
+	!defined(PLAT_RAS_SDEI_EVENT)
+#error "RAS_CE_BATCHING requires PLAT_RAS_CPER_BASE, PLAT_RAS_CPER_SIZE and PLAT_RAS_SDEI_EVENT"
+#endif
+
+#ifndef PLAT_RAS_BATCH_MAX_RECORDS
+#define PLAT_RAS_BATCH_MAX_RECORDS	32U
+#endif
+
+#ifndef PLAT_RAS_CE_STORM_THRESHOLD
+#define PLAT_RAS_CE_STORM_THRESHOLD	16U
+#endif
+
+#ifndef PLAT_RAS_CE_STORM_WINDOW_MS
+#define PLAT_RAS_CE_STORM_WINDOW_MS	1000U
+#endif
+
+#ifndef PLAT_RAS_POLL_PERIOD_MS
+#define PLAT_RAS_POLL_PERIOD_MS		100U
+#endif
+
+CASSERT(PLAT_RAS_CE_STORM_THRESHOLD > 0U, assert_ras_storm_threshold_zero);
+CASSERT(PLAT_RAS_POLL_PERIOD_MS < PLAT_RAS_CE_STORM_WINDOW_MS,
+	assert_ras_poll_period_too_long);
+
+/* CPER Generic Error Status Block, as defined by ACPI for GHES */
+typedef struct cper_gen_err_status {
+	uint32_t block_status;
+	uint32_t raw_data_offset;
+	uint32_t raw_data_length;
+	uint32_t data_length;
+	uint32_t error_severity;
+} cper_gen_err_status_t;
+
+#define CPER_BLOCK_CE_VALID		BIT_32(1)
+#define CPER_BLOCK_MULTI_CE		BIT_32(3)
+#define CPER_BLOCK_COUNT_SHIFT		4
+#define CPER_BLOCK_COUNT_MAX		U(0x3ff)
+
+#define CPER_SEV_CORRECTED		U(2)
+
+/* CPER Generic Error Data Entry, revision 3 */
+typedef struct cper_gen_err_data {
+	struct efi_guid section_type;
+	uint32_t error_severity;
+	uint16_t revision;
+	uint8_t validation_bits;
+	uint8_t flags;
+	uint32_t error_data_length;
+	uint8_t fru_id[16];
+	uint8_t fru_text[20];
+	uint64_t timestamp;
+} cper_gen_err_data_t;
+
+#define CPER_GEN_ERR_DATA_REV		U(0x300)
+
+/*
+ * Section of a Generic Error Data Entry holding the raw contents of a Standard
+ * Error Record. 'node' is the base address of a memory-mapped group, or the
+ * index of the first record of a System register group.
+ */
+typedef struct ras_batch_rec {
+	uint64_t node;
+	uint32_t access;
+	uint32_t idx;
+	uint64_t status;
+	uint64_t addr;
+	uint64_t misc0;
+	uint64_t misc1;
+} ras_batch_rec_t;
+
+/* {e6d6a5c1-4a52-4d0b-9b35-1f3c7d0a2e84} */
+static const struct efi_guid ras_batch_section_guid = {
+	0xe6d6a5c1, 0x4a52, 0x4d0b,
+	{ 0x9b, 0x35, 0x1f, 0x3c, 0x7d, 0x0a, 0x2e, 0x84 }
+};
+
+#define CPER_ENTRY_SIZE		(sizeof(cper_gen_err_data_t) + \
+				 sizeof(ras_batch_rec_t))
+
+CASSERT(sizeof(cper_gen_err_status_t) == 20U, assert_cper_status_size);
+CASSERT(sizeof(cper_gen_err_data_t) == 72U, assert_cper_data_size);
+CASSERT(PLAT_RAS_CPER_SIZE >= (sizeof(cper_gen_err_status_t) + CPER_ENTRY_SIZE),
+	assert_ras_cper_buffer_too_small);
+
+/* Errors found by the scans, and not published to the Normal world yet */
+static ras_batch_rec_t ras_batch_recs[PLAT_RAS_BATCH_MAX_RECORDS];
+static unsigned int ras_batch_num_recs;
+static unsigned int ras_batch_num_dropped;
+
+/* Corrected error interrupts disabled during a storm */
+static struct {
+	uintptr_t base;
+	unsigned int idx;
+} ras_masked[PLAT_RAS_BATCH_MAX_RECORDS];
+static unsigned int ras_num_masked;
+
+/* Corrected error rate tracking */
+static bool ras_storm;
+static uint64_t ras_window_start;
+static unsigned int ras_window_ce;
+
+static spinlock_t ras_batch_lock;
+
+/* Context of a scan of an error record group */
+struct ras_scan_ctx {
+	const struct err_record_info *info;
+	unsigned int num_ce;
+};
+
+static bool ras_is_ce(uint64_t status)
+{
+	return (ERR_STATUS_GET_FIELD(status, UE) == 0U) &&
+		(ERR_STATUS_GET_FIELD(status, DE) == 0U);
+}
+
+static void ras_batch_stage(const ras_batch_rec_t *rec,
+			    struct ras_scan_ctx *ctx)
+{
+	ctx->num_ce++;
+
+	if (ras_batch_num_recs == PLAT_RAS_BATCH_MAX_RECORDS) {
+		ras_batch_num_dropped++;
+		return;
+	}
+
+	ras_batch_recs[ras_batch_num_recs] = *rec;
+	ras_batch_num_recs++;
+}
+
+/* Capture and clear a memory-mapped error record holding a corrected error */
+static void ras_capture_memmap(unsigned int idx, void *arg)
+{
+	struct ras_scan_ctx *ctx = arg;
+	uintptr_t base = ctx->info->memmap.base_addr;
+	ras_batch_rec_t rec = {
+		.node = base,
+		.access = ERR_ACCESS_MEMMAP,
+		.idx = idx,
+	};
+
+	rec.status = ser_get_status(base, idx);
+	if ((ERR_STATUS_GET_FIELD(rec.status, V) == 0U) ||
+	    !ras_is_ce(rec.status)) {
+		return;
+	}
+
+	if (ERR_STATUS_GET_FIELD(rec.status, AV) != 0U) {
+		rec.addr = ser_get_addr(base, idx);
+	}
+
+	if (ERR_STATUS_GET_FIELD(rec.status, MV) != 0U) {
+		rec.misc0 = ser_get_misc0(base, idx);
+		rec.misc1 = ser_get_misc1(base, idx);
+	}
+
+	ser_set_status(base, idx, rec.status);
+
+	ras_batch_stage(&rec, ctx);
+}
+
+/*
+ * Capture and clear the selected System register error record, if it holds a
+ * corrected error
+ */
+static void ras_capture_sysreg(unsigned int idx, void *arg)
+{
+	struct ras_scan_ctx *ctx = arg;
+	ras_batch_rec_t rec = {
+		.node = ctx->info->sysreg.idx_start,
+		.access = ERR_ACCESS_SYSREG,
+		.idx = idx,
+	};
+
+	rec.status = read_erxstatus_el1();
+	if (!ras_is_ce(rec.status)) {
+		return;
+	}
+
+	if (ERR_STATUS_GET_FIELD(rec.status, AV) != 0U) {
+		rec.addr = read_erxaddr_el1();
+	}
+
+	if (ERR_STATUS_GET_FIELD(rec.status, MV) != 0U) {
+		rec.misc0 = read_erxmisc0_el1();
+		rec.misc1 = read_erxmisc1_el1();
+	}
+
+	write_erxstatus_el1(rec.status);
+
+	ras_batch_stage(&rec, ctx);
+}
+
+/* Scan all the error record groups, and return the number of CEs found */
+static unsigned int ras_batch_scan(void)
+{
+	const struct err_record_info *info;
+	struct ras_scan_ctx ctx = { .num_ce = 0U };
+	unsigned int i;
+
+	for_each_err_record_info(i, info) {
+		assert(info->version == ERR_HANDLER_VERSION);
+
+		ctx.info = info;
+		if (info->access == ERR_ACCESS_MEMMAP) {
+			(void)ser_scan_memmap(info->memmap.base_addr,
+					      info->memmap.size_num_k,
+					      ras_capture_memmap, &ctx);
+		} else {
+			(void)ser_scan_sysreg(info->sysreg.idx_start,
+					      info->sysreg.num_idx,
+					      ras_capture_sysreg, &ctx);
+		}
+	}
+
+	return ctx.num_ce;
+}
+
+/*
+ * Disable the corrected error interrupts of the memory-mapped records which
+ * reported the CEs staged from index 'first'. System register records are left
+ * alone, as they can only be accessed by the CPU owning them.
+ */
+static void ras_mask_ce_interrupts(unsigned int first)
+{
+	unsigned int i, j;
+	uint64_t ctlr;
+
+	for (i = first; i < ras_batch_num_recs; i++) {
+		const ras_batch_rec_t *rec = &ras_batch_recs[i];
+
+		if ((rec->access != ERR_ACCESS_MEMMAP) ||
+		    (ras_num_masked == PLAT_RAS_BATCH_MAX_RECORDS)) {
+			continue;
+		}
+
+		for (j = 0U; j < ras_num_masked; j++) {
+			if ((ras_masked[j].base == rec->node) &&
+			    (ras_masked[j].idx == rec->idx)) {
+				break;
+			}
+		}
+
+		if (j < ras_num_masked) {
+			continue;
+		}
+
+		ctlr = ser_get_control(rec->node, rec->idx);
+		if (((ctlr >> ERR_CTLR_CFI_SHIFT) & ERR_CTLR_CFI_MASK) == 0U) {
+			continue;
+		}
+
+		ser_set_control(rec->node, rec->idx,
+				ctlr & ~((uint64_t)ERR_CTLR_CFI_MASK <<
+					 ERR_CTLR_CFI_SHIFT));
+
+		ras_masked[ras_num_masked].base = rec->node;
+		ras_masked[ras_num_masked].idx = rec->idx;
+		ras_num_masked++;
+	}
+}
+
+/* Re-enable the corrected error interrupts disabled during the storm */
+static void ras_unmask_ce_interrupts(void)
+{
+	unsigned int i;
+	uint64_t ctlr;
+
+	for (i = 0U; i < ras_num_masked; i++) {
+		ctlr = ser_get_control(ras_masked[i].base, ras_masked[i].idx);
+		ser_set_control(ras_masked[i].base, ras_masked[i].idx,
+				ctlr | ((uint64_t)ERR_CTLR_CFI_MASK <<
+					ERR_CTLR_CFI_SHIFT));
+	}
+
+	ras_num_masked = 0U;
+}
+
+/*
+ * Track the rate of corrected errors, and switch between interrupt driven and
+ * polled reporting of corrected errors accordingly.
+ */
+static void ras_update_storm(unsigned int num_ce, unsigned int first)
+{
+	uint64_t now = read_cntpct_el0();
+	uint64_t ticks_per_ms = read_cntfrq_el0() / 1000U;
+
+	if (!ras_storm) {
+		if ((now - ras_window_start) >
+		    (ticks_per_ms * PLAT_RAS_CE_STORM_WINDOW_MS)) {
+			ras_window_start = now;
+			ras_window_ce = 0U;
+		}
+
+		ras_window_ce += num_ce;
+		if (ras_window_ce < PLAT_RAS_CE_STORM_THRESHOLD) {
+			return;
+		}
+
+		NOTICE("RAS: corrected error storm, polling error records\n");
+		ras_storm = true;
+	} else if ((num_ce * PLAT_RAS_CE_STORM_WINDOW_MS) <
+		   (PLAT_RAS_CE_STORM_THRESHOLD * PLAT_RAS_POLL_PERIOD_MS)) {
+		/* The rate seen by the last poll is below the threshold */
+		NOTICE("RAS: corrected error storm over\n");
+		ras_unmask_ce_interrupts();
+		ras_storm = false;
+		ras_window_start = now;
+		ras_window_ce = 0U;
+		return;
+	}
+
+	ras_mask_ce_interrupts(first);
+}
+
+/*
+ * Publish the staged errors in the CPER buffer, provided that the Normal world
+ * has consumed the previous block by clearing its status. The block status is
+ * written last, so that the Normal world never sees a partial block.
+ */
+static void ras_batch_publish(void)
+{
+	cper_gen_err_status_t *blk = (cper_gen_err_status_t *)PLAT_RAS_CPER_BASE;
+	uint8_t *entry = (uint8_t *)(blk + 1);
+	uint32_t block_status = CPER_BLOCK_CE_VALID;
+	unsigned int i, n;
+
+	if ((blk->block_status != 0U) || (ras_batch_num_recs == 0U)) {
+		return;
+	}
+
+	n = MIN(ras_batch_num_recs,
+		(unsigned int)((PLAT_RAS_CPER_SIZE - sizeof(*blk)) /
+			       CPER_ENTRY_SIZE));
+	n = MIN(n, CPER_BLOCK_COUNT_MAX);
+
+	for (i = 0U; i < n; i++) {
+		cper_gen_err_data_t *data = (cper_gen_err_data_t *)entry;
+
+		zeromem(data, sizeof(*data));
+		data->section_type = ras_batch_section_guid;
+		data->error_severity = CPER_SEV_CORRECTED;
+		data->revision = CPER_GEN_ERR_DATA_REV;
+		data->error_data_length = sizeof(ras_batch_rec_t);
+		(void)memcpy(data + 1, &ras_batch_recs[i], sizeof(ras_batch_rec_t));
+		entry += CPER_ENTRY_SIZE;
+	}
+
+	/* Keep the errors which did not fit for the next block */
+	ras_batch_num_recs -= n;
+	(void)memmove(&ras_batch_recs[0], &ras_batch_recs[n],
+		      ras_batch_num_recs * sizeof(ras_batch_rec_t));
+
+	if ((n > 1U) || (ras_batch_num_dropped != 0U)) {
+		block_status |= CPER_BLOCK_MULTI_CE;
+	}
+	block_status |= (uint32_t)n << CPER_BLOCK_COUNT_SHIFT;
+
+	if (ras_batch_num_dropped != 0U) {
+		WARN("RAS: %u errors dropped\n", ras_batch_num_dropped);
+		ras_batch_num_dropped = 0U;
+	}
+
+	blk->raw_data_offset = 0U;
+	blk->raw_data_length = 0U;
+	blk->data_length = n * (uint32_t)CPER_ENTRY_SIZE;
+	blk->error_severity = CPER_SEV_CORRECTED;
+
+	dmbish();
+
+	blk->block_status = block_status;
+}
+
+/*
+ * Capture the corrected errors of all the error record groups. This is called
+ * for every RAS interrupt, including the polling timer, before the handler of
+ * the error record group associated with the interrupt.
+ */
+void ras_batch_collect(void)
+{
+	unsigned int first, num_ce;
+
+	spin_lock(&ras_batch_lock);
+
+	first = ras_batch_num_recs;
+	num_ce = ras_batch_scan();
+	ras_update_storm(num_ce, first);
+
+	spin_unlock(&ras_batch_lock);
+}
+
+/*
+ * Publish the corrected errors captured so far and notify the Normal world.
+ * This is called once the RAS interrupt has been completed. If the interrupt
+ * preempted the Secure world, it is resumed once the Normal world has handled
+ * the event.
+ */
+void ras_batch_report(uint32_t flags)
+{
+	const cper_gen_err_status_t *blk =
+		(const cper_gen_err_status_t *)PLAT_RAS_CPER_BASE;
+	unsigned int sec_state = get_interrupt_src_ss(flags);
+	bool notify, rearm;
+
+	spin_lock(&ras_batch_lock);
+
+	ras_batch_publish();
+
+	/*
+	 * Also notify for a block published earlier and not consumed, e.g.
+	 * because no client was registered for the event then.
+	 */
+	notify = blk->block_status != 0U;
+	rearm = ras_storm || (ras_batch_num_recs != 0U);
+
+	spin_unlock(&ras_batch_lock);
+
+	if (rearm) {
+		plat_ras_poll_timer_arm(PLAT_RAS_POLL_PERIOD_MS);
+	}
+
+	if (!notify) {
+		return;
+	}
+
+	/* The dispatch resumes the Normal world context */
+	if (sec_state == SECURE) {
+		cm_el1_sysregs_context_save(SECURE);
+	} else {
+		cm_el1_sysregs_context_save(NON_SECURE);
+	}
+
+	if (sdei_dispatch_event(PLAT_RAS_SDEI_EVENT) != 0) {
+		VERBOSE("RAS: failed to dispatch SDEI event %d\n",
+			PLAT_RAS_SDEI_EVENT);
+	}
+
+	if (sec_state == SECURE) {
+		cm_el1_sysregs_context_restore(SECURE);
+		cm_set_next_eret_context(SECURE);
+	}
+}
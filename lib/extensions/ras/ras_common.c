@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2021, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2018-2023, Arm Limited and Contributors. All rights reserved.
  * Copyright (c) 2020, NVIDIA Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -159,9 +159,30 @@ static int ras_interrupt_handler(uint32_t intr_raw, uint32_t flags,
 		panic();
 	}
 
+#if RAS_CE_BATCHING
+	/*
+	 * Capture the corrected errors of all the error record groups. The
+	 * uncorrected and deferred errors are left in their records for the
+	 * handler of the record group.
+	 */
+	ras_batch_collect();
+#endif
+
 	if (selected->err_record->probe != NULL) {
 		ret = selected->err_record->probe(selected->err_record, &probe_data);
+#if RAS_CE_BATCHING
+		if (ret == 0) {
+			/*
+			 * Only corrected errors were signalled, or the
+			 * interrupt is the polling timer.
+			 */
+			plat_ic_end_of_interrupt(intr_raw);
+			ras_batch_report(flags);
+			return 0;
+		}
+#else
 		assert(ret != 0);
+#endif
 	}
 
 	/* Call error handler for the record group */
@@ -169,6 +190,10 @@ static int ras_interrupt_handler(uint32_t intr_raw, uint32_t flags,
 	(void) selected->err_record->handler(selected->err_record, probe_data,
 			&err_data);
 
+#if RAS_CE_BATCHING
+	ras_batch_report(flags);
+#endif
+
 	return 0;
 }
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2018-2023, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -77,3 +77,76 @@ int ser_probe_sysreg(unsigned int idx_start, unsigned int num_idx, int *probe_da
 
 	return 0;
 }
+
+/*
+ * Scan memory-mapped registers containing error records implemented in
+ * Standard Error Record format for all the records in error. Only the group
+ * status registers and the records they flag are read. Call the callback with
+ * the index of each record in error, and return the number of such records.
+ */
+unsigned int ser_scan_memmap(uintptr_t base, unsigned int size_num_k,
+		ser_scan_cb_t cb, void *arg)
+{
+	unsigned int num_records, num_group_regs, i, count = 0U;
+	uint64_t gsr;
+
+	assert(base != 0UL);
+	assert(cb != NULL);
+
+	/* Only 4K supported for now */
+	assert(size_num_k == STD_ERR_NODE_SIZE_NUM_K);
+
+	num_records = (unsigned int)
+		(mmio_read_32(ERR_DEVID(base, size_num_k)) & ERR_DEVID_MASK);
+
+	/* A group register shows error status for 2^6 error records */
+	num_group_regs = (num_records + 63U) >> 6U;
+
+	for (i = 0; i < num_group_regs; i++) {
+		gsr = mmio_read_64(ERR_GSR(base, size_num_k, i));
+
+		/* Visit the set bits only, lowest first */
+		while (gsr != 0ULL) {
+			cb((i << 6U) + (unsigned int)__builtin_ctzll(gsr), arg);
+			gsr &= gsr - 1ULL;
+			count++;
+		}
+	}
+
+	return count;
+}
+
+/*
+ * Scan System Registers where error records are implemented in Standard Error
+ * Record format for all the records in error. The callback is called with the
+ * index of each record in error, relative to idx_start, while the record is
+ * selected. Return the number of records in error.
+ */
+unsigned int ser_scan_sysreg(unsigned int idx_start, unsigned int num_idx,
+		ser_scan_cb_t cb, void *arg)
+{
+	unsigned int i, count = 0U;
+	uint64_t status;
+	unsigned int max_idx __unused =
+		((unsigned int) read_erridr_el1()) & ERRIDR_MASK;
+
+	assert(cb != NULL);
+	assert(idx_start < max_idx);
+	assert(check_u32_overflow(idx_start, num_idx) == 0);
+	assert((idx_start + num_idx - 1U) < max_idx);
+
+	for (i = 0; i < num_idx; i++) {
+		/* Select the error record */
+		ser_sys_select_record(idx_start + i);
+
+		/* Retrieve status register from the error record */
+		status = read_erxstatus_el1();
+
+		if (ERR_STATUS_GET_FIELD(status, V) != 0U) {
+			cb(i, arg);
+			count++;
+		}
+	}
+
+	return count;
+}
@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <stdint.h>
+
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <lib/bootmarker_capture.h>
+#include <lib/pmf/pmf.h>
+#include <lib/utils_def.h>
+#include <plat/common/platform.h>
+
+/*******************************************************************************
+ * The boot phase log is either placed in platform provided memory, which
+ * survives the hand-over from one boot stage to the next, or in a buffer
+ * private to the current image. In the latter case each image prints its own
+ * records when it exits.
+ ******************************************************************************/
+#ifdef PLAT_BOOTMARKER_LOG_BASE
+#define BOOT_PHASE_LOG_PERSISTENT	1
+#define BOOT_PHASE_LOG_BASE		((uintptr_t)PLAT_BOOTMARKER_LOG_BASE)
+#define BOOT_PHASE_LOG_SIZE		(PLAT_BOOTMARKER_LOG_SIZE)
+#else
+#define BOOT_PHASE_LOG_PERSISTENT	0
+#define BOOT_PHASE_LOG_SIZE		U(2048)
+
+static uint64_t boot_phase_log_mem[BOOT_PHASE_LOG_SIZE / sizeof(uint64_t)];
+#define BOOT_PHASE_LOG_BASE		((uintptr_t)boot_phase_log_mem)
+#endif
+
+CASSERT(BOOT_PHASE_LOG_SIZE >= (sizeof(boot_phase_log_t) +
+	sizeof(boot_phase_rec_t)), assert_boot_phase_log_size_too_small);
+
+static boot_phase_log_t *boot_phase_log;
+
+static const char *const boot_phase_names[BOOT_PHASE_TOTAL_IDS] = {
+	[BOOT_PHASE_IMG_OPEN]		= "img_open",
+	[BOOT_PHASE_IMG_READ]		= "img_read",
+	[BOOT_PHASE_IMG_PARSE]		= "img_parse",
+	[BOOT_PHASE_IMG_VERIFY]		= "img_verify",
+	[BOOT_PHASE_IMG_HASH]		= "img_hash",
+	[BOOT_PHASE_IMG_MEASURE]	= "img_measure",
+	[BOOT_PHASE_IMG_DECOMPRESS]	= "img_decompress",
+	[BOOT_PHASE_CONSOLE_INIT]	= "console_init",
+	[BOOT_PHASE_XLAT_INIT]		= "xlat_init",
+	[BOOT_PHASE_GIC_INIT]		= "gic_init",
+	[BOOT_PHASE_PSCI_SETUP]		= "psci_setup",
+	[BOOT_PHASE_PLAT_SETUP]		= "plat_setup",
+};
+
+/*
+ * Return the boot phase log, initialising it on first use. BL1 always starts
+ * a fresh log. Later stages reuse a log handed over by the previous stage if
+ * its header is valid, which is not the case e.g. with RESET_TO_BL2 or
+ * RESET_TO_BL31.
+ */
+static boot_phase_log_t *get_boot_phase_log(void)
+{
+	boot_phase_log_t *log = boot_phase_log;
+	uint32_t max_recs = (uint32_t)((BOOT_PHASE_LOG_SIZE -
+		sizeof(boot_phase_log_t)) / sizeof(boot_phase_rec_t));
+
+	if (log != NULL) {
+		return log;
+	}
+
+	log = (boot_phase_log_t *)BOOT_PHASE_LOG_BASE;
+
+#if BOOT_PHASE_LOG_PERSISTENT && !defined(IMAGE_BL1)
+	inv_dcache_range(BOOT_PHASE_LOG_BASE, BOOT_PHASE_LOG_SIZE);
+
+	if ((log->magic == BOOT_PHASE_LOG_MAGIC) &&
+	    (log->max_recs == max_recs) && (log->num_recs <= max_recs)) {
+		boot_phase_log = log;
+		return log;
+	}
+#endif
+
+	log->magic = BOOT_PHASE_LOG_MAGIC;
+	log->max_recs = max_recs;
+	log->num_recs = 0U;
+	log->dropped = 0U;
+
+	boot_phase_log = log;
+
+	return log;
+}
+
+/*
+ * Record the start of a boot phase. Phases are only recorded by the primary
+ * CPU during cold boot, so no locking is required.
+ */
+void bootmarker_phase_start(unsigned int phase, unsigned int image_id)
+{
+	boot_phase_log_t *log = get_boot_phase_log();
+	boot_phase_rec_t *rec;
+
+	assert(phase < BOOT_PHASE_TOTAL_IDS);
+
+	if (log->num_recs >= log->max_recs) {
+		log->dropped++;
+		return;
+	}
+
+	rec = &log->recs[log->num_recs];
+	rec->phase = phase;
+	rec->image_id = image_id;
+	rec->end = 0ULL;
+	rec->start = read_cntpct_el0();
+	log->num_recs++;
+}
+
+/*
+ * Record the end of a boot phase. The most recent matching record which has
+ * not been closed yet is updated, so that phases may nest.
+ */
+void bootmarker_phase_end(unsigned int phase, unsigned int image_id)
+{
+	unsigned long long ts = read_cntpct_el0();
+	boot_phase_log_t *log = get_boot_phase_log();
+	unsigned int i;
+
+	for (i = log->num_recs; i > 0U; i--) {
+		boot_phase_rec_t *rec = &log->recs[i - 1U];
+
+		if ((rec->phase == phase) && (rec->image_id == image_id) &&
+		    (rec->end == 0ULL)) {
+			rec->end = ts;
+			return;
+		}
+	}
+}
+
+static unsigned long long ticks_to_us(unsigned long long ticks,
+				      unsigned long long freq)
+{
+	if (freq == 0ULL) {
+		return 0ULL;
+	}
+
+	return ((ticks / freq) * 1000000ULL) +
+		(((ticks % freq) * 1000000ULL) / freq);
+}
+
+/*
+ * The printf() of TF-A supports neither field widths nor the '-' flag, so the
+ * columns of the table are padded with spaces by hand.
+ */
+static void print_spaces(unsigned int n)
+{
+	while (n-- != 0U) {
+		(void)putchar(' ');
+	}
+}
+
+static unsigned int num_digits(unsigned long long n)
+{
+	unsigned int digits = 1U;
+
+	while (n >= 10ULL) {
+		n /= 10ULL;
+		digits++;
+	}
+
+	return digits;
+}
+
+/* Print `str` left aligned in a column of `width` characters */
+static void print_str_col(const char *str, unsigned int width)
+{
+	unsigned int len = 0U;
+
+	while (str[len] != '\0') {
+		len++;
+	}
+
+	printf("%s", str);
+	print_spaces((len < width) ? (width - len) : 0U);
+}
+
+/* Print `n` right aligned in a column of `width` characters */
+static void print_num_col(unsigned long long n, unsigned int width)
+{
+	unsigned int len = num_digits(n);
+
+	print_spaces((len < width) ? (width - len) : 0U);
+	printf("%llu", n);
+}
+
+/*
+ * Print the boot phase records as a table. When the log is handed over to the
+ * next stage, BL1 and BL2 only write it back to memory and the whole table is
+ * printed once by BL31.
+ */
+void bootmarker_dump(void)
+{
+	boot_phase_log_t *log = get_boot_phase_log();
+	unsigned long long freq = read_cntfrq_el0();
+	unsigned long long base;
+	unsigned int i;
+
+#if BOOT_PHASE_LOG_PERSISTENT
+	flush_dcache_range(BOOT_PHASE_LOG_BASE, BOOT_PHASE_LOG_SIZE);
+#ifndef IMAGE_BL31
+	return;
+#endif
+#endif
+
+	if (log->num_recs == 0U) {
+		return;
+	}
+
+	base = log->recs[0].start;
+
+	printf("Boot phase timings (us, relative to first record):\n");
+	printf("  ");
+	print_str_col("phase", 17U);
+	print_str_col("image", 11U);
+	print_spaces(7U);
+	printf("start");
+	print_spaces(5U);
+	printf("duration\n");
+
+	for (i = 0U; i < log->num_recs; i++) {
+		const boot_phase_rec_t *rec = &log->recs[i];
+		unsigned long long duration = 0ULL;
+
+		if (rec->end >= rec->start) {
+			duration = rec->end - rec->start;
+		}
+
+		printf("  ");
+		print_str_col(boot_phase_names[rec->phase], 17U);
+		if (rec->image_id == BOOT_PHASE_NO_IMAGE) {
+			print_str_col("-", 11U);
+		} else {
+			printf("%u", rec->image_id);
+			print_spaces(11U - num_digits(rec->image_id));
+		}
+		print_num_col(ticks_to_us(rec->start - base, freq), 12U);
+		print_num_col(ticks_to_us(duration, freq), 13U);
+		printf("%s\n", (rec->end == 0ULL) ? " (open)" : "");
+	}
+
+	if (log->dropped != 0U) {
+		printf("  %u records dropped\n", log->dropped);
+	}
+}
+
+#ifdef IMAGE_BL31
+/*
+ * PMF handler returning the accumulated number of counter ticks spent in the
+ * boot phase encoded in 'tid', across all images. 'mpidr' is ignored as boot
+ * phases are only recorded by the primary CPU.
+ */
+static unsigned long long bootmarker_get_phase_ticks(unsigned int tid,
+						     u_register_t mpidr,
+						     unsigned int flags)
+{
+	boot_phase_log_t *log = get_boot_phase_log();
+	unsigned int phase = tid & PMF_TID_MASK;
+	unsigned long long total = 0ULL;
+	unsigned int i;
+
+	(void)mpidr;
+	(void)flags;
+
+	for (i = 0U; i < log->num_recs; i++) {
+		const boot_phase_rec_t *rec = &log->recs[i];
+
+		if ((rec->phase == phase) && (rec->end >= rec->start)) {
+			total += rec->end - rec->start;
+		}
+	}
+
+	return total;
+}
+
+PMF_REGISTER_SERVICE_SMC_OWN(boot_phase_svc, PMF_ARM_TIF_IMPL_ID,
+	PMF_BOOT_PHASE_SVC_ID, BOOT_PHASE_TOTAL_IDS, NULL,
+	bootmarker_get_phase_ticks)
+#endif /* IMAGE_BL31 */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2018, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2023, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -58,6 +58,12 @@ int pmf_setup(void)
 	int rc, ii, jj = 0;
 	int pmf_svc_descs_num, temp_val;
 
+#if ENABLE_PMF_TRACE
+	rc = pmf_trace_setup();
+	if (rc != 0)
+		return rc;
+#endif
+
 	/* If no PMF services are registered then simply bail out */
 	pmf_svc_descs_num = (PMF_SVC_DESCS_END - PMF_SVC_DESCS_START)/
 				 sizeof(pmf_svc_desc_t);
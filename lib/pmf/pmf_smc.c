@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2018, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2023, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -26,6 +26,24 @@ uintptr_t pmf_smc_handler(unsigned int smc_fid,
 	int rc;
 	unsigned long long ts_value;
 
+#if ENABLE_PMF_TRACE
+	if ((smc_fid == PMF_SMC_GET_TRACE_INFO_32) ||
+	    (smc_fid == PMF_SMC_GET_TRACE_INFO_64)) {
+		uintptr_t base;
+		size_t size, ring_size;
+
+		/*
+		 * Return the location of the trace rings to the caller.
+		 * x0 --> error code.
+		 * x1 --> base address of the trace rings.
+		 * x2 --> total size of the trace rings.
+		 * x3 --> size of the trace ring of each CPU.
+		 */
+		pmf_trace_get_info(&base, &size, &ring_size);
+		SMC_RET4(handle, 0, base, size, ring_size);
+	}
+#endif
+
 	/* Determine if the cpu exists of not */
 	if (!is_valid_mpidr(x2))
 		return PSCI_E_INVALID_PARAMS;
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <platform_def.h>
+
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <lib/pmf/pmf.h>
+#include <lib/utils_def.h>
+#include <plat/common/platform.h>
+
+/*******************************************************************************
+ * The PMF trace rings live in a Non-secure memory region provided and mapped
+ * by the platform, so that they can be read by the Normal world without any
+ * SMC. The region is split evenly between the CPUs. Each ring starts on a
+ * cache line boundary and has a single writer, so that no cache line is ever
+ * written by more than one CPU.
+ ******************************************************************************/
+#if !defined(PLAT_PMF_TRACE_BASE) || !defined(PLAT_PMF_TRACE_SIZE)
+#error "ENABLE_PMF_TRACE requires PLAT_PMF_TRACE_BASE and PLAT_PMF_TRACE_SIZE"
+#endif
+
+#define PMF_TRACE_RING_SIZE	((PLAT_PMF_TRACE_SIZE / PLATFORM_CORE_COUNT) & \
+				 ~(CACHE_WRITEBACK_GRANULE - 1U))
+
+/* The records follow the ring header, in the next cache line */
+#define PMF_TRACE_RECS_OFFSET	CACHE_WRITEBACK_GRANULE
+
+CASSERT(sizeof(pmf_trace_ring_t) <= PMF_TRACE_RECS_OFFSET,
+	assert_pmf_trace_ring_hdr_size);
+CASSERT(PMF_TRACE_RING_SIZE >= (PMF_TRACE_RECS_OFFSET +
+	sizeof(pmf_trace_rec_t)), assert_pmf_trace_ring_too_small);
+CASSERT((PLAT_PMF_TRACE_BASE & (CACHE_WRITEBACK_GRANULE - 1U)) == 0U,
+	assert_pmf_trace_base_unaligned);
+
+/*
+ * Number of records in each ring, rounded down to a power of two so that the
+ * index of a record is obtained by masking the head.
+ */
+static uint32_t pmf_trace_num_recs;
+
+static inline pmf_trace_ring_t *get_ring(unsigned int cpu_idx)
+{
+	return (pmf_trace_ring_t *)(PLAT_PMF_TRACE_BASE +
+		((uintptr_t)cpu_idx * PMF_TRACE_RING_SIZE));
+}
+
+/*
+ * Initialise the trace rings of all the CPUs. This is called once, by the
+ * primary CPU during cold boot.
+ */
+int pmf_trace_setup(void)
+{
+	size_t max_recs = (PMF_TRACE_RING_SIZE - PMF_TRACE_RECS_OFFSET) /
+			  sizeof(pmf_trace_rec_t);
+	unsigned int i;
+
+	pmf_trace_num_recs = 1U;
+	while (((size_t)pmf_trace_num_recs << 1) <= max_recs) {
+		pmf_trace_num_recs <<= 1;
+	}
+
+	for (i = 0U; i < PLATFORM_CORE_COUNT; i++) {
+		pmf_trace_ring_t *ring = get_ring(i);
+
+		ring->magic = PMF_TRACE_RING_MAGIC;
+		ring->num_recs = pmf_trace_num_recs;
+		ring->head = 0ULL;
+	}
+
+	flush_dcache_range(PLAT_PMF_TRACE_BASE,
+			   (size_t)PLATFORM_CORE_COUNT * PMF_TRACE_RING_SIZE);
+
+	/* Secondary CPUs may read this with their data cache disabled */
+	flush_dcache_range((uintptr_t)&pmf_trace_num_recs,
+			   sizeof(pmf_trace_num_recs));
+
+	INFO("PMF: %u trace records per CPU at 0x%lx\n", pmf_trace_num_recs,
+	     (unsigned long)PLAT_PMF_TRACE_BASE);
+
+	return 0;
+}
+
+/*
+ * Append a record to the trace ring of the current CPU. The record is written
+ * before the head is updated, so that a reader which observes the new head
+ * also observes the record. When the data cache may be disabled, as requested
+ * with PMF_CACHE_MAINT, the record and the header are also cleaned to memory.
+ *
+ * If the data cache of the calling CPU is disabled, e.g. on the power down
+ * path, the header and the record are accessed in memory directly. Their
+ * cache lines are cleaned and invalidated first, so that the head is not read
+ * stale from memory and a dirty line is not later evicted over the record.
+ */
+void __pmf_trace_record(unsigned int id, unsigned long long ts, uint32_t arg,
+			unsigned int flags)
+{
+	pmf_trace_ring_t *ring = get_ring(plat_my_core_pos());
+	bool dcache_off = (read_sctlr_el3() & SCTLR_C_BIT) == 0U;
+	unsigned long long head;
+	pmf_trace_rec_t *rec;
+
+	/* Records captured before the rings are initialised are dropped */
+	if (pmf_trace_num_recs == 0U) {
+		return;
+	}
+
+	if (dcache_off) {
+		flush_dcache_range((uintptr_t)ring, sizeof(*ring));
+	}
+
+	head = ring->head;
+	rec = (pmf_trace_rec_t *)((uintptr_t)ring + PMF_TRACE_RECS_OFFSET) +
+		(head & (pmf_trace_num_recs - 1U));
+
+	if (dcache_off) {
+		flush_dcache_range((uintptr_t)rec, sizeof(*rec));
+	}
+
+	rec->ts = ts;
+	rec->id = id;
+	rec->arg = arg;
+
+	dmbishst();
+
+	ring->head = head + 1ULL;
+
+	if ((flags & PMF_CACHE_MAINT) != 0U) {
+		flush_dcache_range((uintptr_t)rec, sizeof(*rec));
+		flush_dcache_range((uintptr_t)ring, sizeof(*ring));
+	}
+}
+
+/* Return the location of the trace rings and the size of each of them */
+void pmf_trace_get_info(uintptr_t *base, size_t *size, size_t *ring_size)
+{
+	assert((base != NULL) && (size != NULL) && (ring_size != NULL));
+
+	*base = PLAT_PMF_TRACE_BASE;
+	*size = (size_t)PLATFORM_CORE_COUNT * PMF_TRACE_RING_SIZE;
+	*ring_size = PMF_TRACE_RING_SIZE;
+}
@@ -974,6 +974,17 @@ void psci_warmboot_entrypoint(void)
 	/* Init registers that never change for the lifetime of TF-A */
 	cm_manage_extensions_el3();
 
+#if PSCI_EARLY_CPU_INIT
+	/*
+	 * A secondary cpu released during cold boot initialises itself and
+	 * waits in the EL3 holding pen until it is turned ON.
+	 */
+	if (psci_get_pen_state() == PSCI_PEN_INIT) {
+		psci_pen_entry(cpu_idx);
+		return;
+	}
+#endif
+
 	/*
 	 * Verify that we have been explicitly turned ON or resumed from
 	 * suspend.
@@ -1035,6 +1046,10 @@ void psci_warmboot_entrypoint(void)
 	 */
 	psci_set_pwr_domains_to_run(end_pwrlvl);
 
+#if PSCI_EARLY_CPU_INIT || PSCI_CPU_OFF_TO_PEN
+	psci_pen_reset(&state_info);
+#endif
+
 #if ENABLE_PSCI_STAT
 	/*
 	 * Update PSCI stats.
@@ -161,6 +161,19 @@ int psci_cpu_suspend(unsigned int power_state,
 			return rc;
 	}
 
+#if PSCI_OS_INIT_MODE && (PSCI_EARLY_CPU_INIT || PSCI_CPU_OFF_TO_PEN)
+	/*
+	 * In OS-initiated mode the caller is the last running CPU of the power
+	 * domains it suspends, as far as the OS is concerned. The CPUs parked
+	 * in the holding pen there are still running, so power them down.
+	 */
+	if (psci_suspend_mode == OS_INIT) {
+		rc = psci_pen_power_down(target_pwrlvl);
+		if (rc != PSCI_E_SUCCESS)
+			return rc;
+	}
+#endif
+
 	/*
 	 * Do what is needed to enter the power down state. Upon success,
 	 * enter the final wfi which will power down this CPU. This function
@@ -170,7 +183,8 @@ int psci_cpu_suspend(unsigned int power_state,
 	rc = psci_cpu_suspend_start(&ep,
 				    target_pwrlvl,
 				    &state_info,
-				    is_power_down_state);
+				    is_power_down_state,
+				    false);
 
 	return rc;
 }
@@ -207,6 +221,15 @@ int psci_system_suspend(uintptr_t entrypoint, u_register_t context_id)
 	assert(is_local_state_off(
 			state_info.pwr_domain_state[PLAT_MAX_PWR_LVL]) != 0);
 
+#if PSCI_EARLY_CPU_INIT || PSCI_CPU_OFF_TO_PEN
+	/*
+	 * The CPUs parked in the holding pen are OFF for the check above but
+	 * are still running. Power them down before suspending the system.
+	 */
+	if (psci_pen_power_down(PLAT_MAX_PWR_LVL) != PSCI_E_SUCCESS)
+		return PSCI_E_DENIED;
+#endif
+
 	/*
 	 * Do what is needed to enter the system suspend state. This function
 	 * might return if the power down was abandoned for any reason, e.g.
@@ -215,7 +238,8 @@ int psci_system_suspend(uintptr_t entrypoint, u_register_t context_id)
 	rc = psci_cpu_suspend_start(&ep,
 				    PLAT_MAX_PWR_LVL,
 				    &state_info,
-				    PSTATE_TYPE_POWERDOWN);
+				    PSTATE_TYPE_POWERDOWN,
+				    true);
 
 	return rc;
 }
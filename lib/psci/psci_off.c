@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2019, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2023, ARM Limited and Contributors. All rights reserved.
  * Copyright (c) 2023, NVIDIA Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -11,6 +11,7 @@
 #include <arch.h>
 #include <arch_helpers.h>
 #include <common/debug.h>
+#include <drivers/console_ring.h>
 #include <lib/pmf/pmf.h>
 #include <lib/runtime_instr.h>
 #include <plat/common/platform.h>
@@ -54,6 +55,9 @@ int psci_do_cpu_off(unsigned int end_pwrlvl)
 	 */
 	assert(psci_plat_pm_ops->pwr_domain_off != NULL);
 
+	/* Write out the buffered console output while the CPU is still up */
+	console_ring_drain(false);
+
 	/* Construct the psci_power_state for CPU_OFF */
 	psci_set_power_off_state(&state_info);
 
@@ -97,6 +101,18 @@ int psci_do_cpu_off(unsigned int end_pwrlvl)
 			goto exit;
 	}
 
+#if PSCI_CPU_OFF_TO_PEN
+	/*
+	 * Keep this cpu powered up and initialised in the EL3 holding pen
+	 * instead of turning it off, so that a later CPU_ON only needs to
+	 * release it. The cpu and its ancestors remain in the RUN state.
+	 */
+	psci_release_pwr_domain_locks(end_pwrlvl, parent_nodes);
+
+	psci_pen_enter();
+	psci_pen_park();
+#endif
+
 	/*
 	 * This function is passed the requested state info and
 	 * it returns the negotiated state info for each power level upto
@@ -196,3 +212,61 @@ exit:
 
 	return rc;
 }
+
+#if PSCI_EARLY_CPU_INIT || PSCI_CPU_OFF_TO_PEN
+/******************************************************************************
+ * Called by a cpu parked in the EL3 holding pen when it has been asked to
+ * power down. The cpu is OFF as far as AFFINITY_INFO is concerned, and the
+ * Secure Payload Dispatcher either never saw it turned on or has already been
+ * told that it was turned off, so only the power state coordination and the
+ * power down itself remain to be done.
+ ******************************************************************************/
+void __dead2 psci_pen_cpu_off(void)
+{
+	unsigned int end_pwrlvl = PLAT_MAX_PWR_LVL;
+	unsigned int idx = plat_my_core_pos();
+	psci_power_state_t state_info;
+	unsigned int parent_nodes[PLAT_MAX_PWR_LVL] = {0};
+
+	assert(psci_plat_pm_ops->pwr_domain_off != NULL);
+
+	psci_set_power_off_state(&state_info);
+
+	psci_get_parent_pwr_domain_nodes(idx, end_pwrlvl, parent_nodes);
+	psci_acquire_pwr_domain_locks(end_pwrlvl, parent_nodes);
+
+	psci_do_state_coordination(end_pwrlvl, &state_info);
+	psci_set_target_local_pwr_states(end_pwrlvl, &state_info);
+
+#if ENABLE_PSCI_STAT
+	psci_stats_update_pwr_down(end_pwrlvl, &state_info);
+#endif
+
+	psci_pwrdown_cpu(psci_find_max_off_lvl(&state_info));
+
+	psci_plat_pm_ops->pwr_domain_off(&state_info);
+
+#if ENABLE_PSCI_STAT
+	plat_psci_stat_accounting_start(&state_info);
+#endif
+
+	psci_release_pwr_domain_locks(end_pwrlvl, parent_nodes);
+
+	/*
+	 * Let the cpu which requested the power down know that this cpu no
+	 * longer takes part in state coordination. As for aff_info_state in
+	 * psci_do_cpu_off(), this is written with the caches disabled.
+	 */
+	psci_flush_cpu_data(psci_svc_cpu_data.pen_state);
+	psci_set_pen_state(PSCI_PEN_NONE);
+	psci_dsbish();
+	psci_inv_cpu_data(psci_svc_cpu_data.pen_state);
+
+	if (psci_plat_pm_ops->pwr_domain_pwr_down_wfi != NULL) {
+		/* This function must not return */
+		psci_plat_pm_ops->pwr_domain_pwr_down_wfi(&state_info);
+	}
+
+	psci_power_down_wfi();
+}
+#endif /* PSCI_EARLY_CPU_INIT || PSCI_CPU_OFF_TO_PEN */
@@ -1,22 +1,36 @@
 /*
- * Copyright (c) 2013-2022, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2023, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <assert.h>
+#include <stdbool.h>
 #include <stddef.h>
 
 #include <arch.h>
 #include <arch_helpers.h>
 #include <common/bl_common.h>
 #include <common/debug.h>
+#include <drivers/delay_timer.h>
 #include <lib/el3_runtime/context_mgmt.h>
 #include <lib/el3_runtime/pubsub_events.h>
+#include <lib/pmf/pmf.h>
+#include <lib/runtime_instr.h>
 #include <plat/common/platform.h>
 
 #include "psci_private.h"
 
+#if PSCI_EARLY_CPU_INIT || PSCI_CPU_OFF_TO_PEN
+/* Time given to the parked cpus to power down when asked to */
+#define PSCI_PEN_OFF_TIMEOUT_MS		U(100)
+#endif
+
+#if PSCI_EARLY_CPU_INIT
+/* Time given to the secondary cpus to reach the holding pen at cold boot */
+#define PSCI_EARLY_CPU_INIT_TIMEOUT_MS	U(1000)
+#endif
+
 /*
  * Helper functions for the CPU level spinlocks
  */
@@ -46,6 +60,127 @@ static int cpu_on_validate_state(aff_info_state_t aff_state)
 	return PSCI_E_SUCCESS;
 }
 
+#if PSCI_EARLY_CPU_INIT || PSCI_CPU_OFF_TO_PEN
+/*******************************************************************************
+ * Release a cpu parked in the EL3 holding pen. The caller has already stored
+ * the non-secure entry point of the target cpu.
+ ******************************************************************************/
+static void psci_pen_release(unsigned int target_idx)
+{
+	/* Make the context visible before the cpu leaves the pen */
+	dmbish();
+	psci_set_pen_state_by_idx(target_idx, PSCI_PEN_RELEASED);
+	dsbish();
+	sev();
+}
+
+/*******************************************************************************
+ * Returns true if the cpu at index `idx` is in the power domain at level
+ * `pwrlvl` whose ancestor nodes down to the cpu level are `nodes`.
+ ******************************************************************************/
+static bool psci_pen_cpu_in_domain(unsigned int idx, unsigned int pwrlvl,
+				   const unsigned int *nodes)
+{
+	unsigned int idx_nodes[PLAT_MAX_PWR_LVL] = {0};
+
+	psci_get_parent_pwr_domain_nodes(idx, pwrlvl, idx_nodes);
+
+	return idx_nodes[pwrlvl - 1U] == nodes[pwrlvl - 1U];
+}
+
+/*******************************************************************************
+ * Power down the cpus parked in the EL3 holding pen which share the power
+ * domain of the calling cpu at level `end_pwrlvl`. A parked cpu is OFF as far
+ * as AFFINITY_INFO is concerned but keeps its ancestors in the RUN state, so
+ * this has to be done before the requests which rely on the calling cpu being
+ * the last one running in that power domain. Returns PSCI_E_DENIED if one of
+ * them failed to power down in time.
+ ******************************************************************************/
+int psci_pen_power_down(unsigned int end_pwrlvl)
+{
+	unsigned int idx, my_idx = plat_my_core_pos();
+	unsigned int wait_ms = PSCI_PEN_OFF_TIMEOUT_MS;
+	unsigned int nodes[PLAT_MAX_PWR_LVL] = {0};
+	bool requested = false;
+
+	if (end_pwrlvl == PSCI_CPU_PWR_LVL) {
+		return PSCI_E_SUCCESS;
+	}
+
+	psci_get_parent_pwr_domain_nodes(my_idx, end_pwrlvl, nodes);
+
+	for (idx = 0U; idx < psci_plat_core_count; idx++) {
+		if ((idx == my_idx) ||
+		    !psci_pen_cpu_in_domain(idx, end_pwrlvl, nodes)) {
+			continue;
+		}
+
+		/* Serialise against a CPU_ON releasing the same cpu */
+		psci_spin_lock_cpu(idx);
+		if (psci_get_pen_state_by_idx(idx) == PSCI_PEN_PARKED) {
+			psci_set_pen_state_by_idx(idx, PSCI_PEN_OFF);
+			requested = true;
+		}
+		psci_spin_unlock_cpu(idx);
+	}
+
+	if (!requested) {
+		return PSCI_E_SUCCESS;
+	}
+
+	dsbish();
+	sev();
+
+	/*
+	 * Each cpu clears its pen state with the caches off once it no longer
+	 * takes part in state coordination.
+	 */
+	for (idx = 0U; idx < psci_plat_core_count; idx++) {
+		if ((idx == my_idx) ||
+		    !psci_pen_cpu_in_domain(idx, end_pwrlvl, nodes)) {
+			continue;
+		}
+
+		flush_cpu_data_by_index(idx, psci_svc_cpu_data.pen_state);
+		while ((psci_get_pen_state_by_idx(idx) == PSCI_PEN_OFF) &&
+		       (wait_ms != 0U)) {
+			mdelay(1U);
+			wait_ms--;
+			flush_cpu_data_by_index(idx,
+						psci_svc_cpu_data.pen_state);
+		}
+
+		if (psci_get_pen_state_by_idx(idx) == PSCI_PEN_OFF) {
+			ERROR("PSCI: Parked CPU %u failed to power down\n",
+			      idx);
+			return PSCI_E_DENIED;
+		}
+	}
+
+	return PSCI_E_SUCCESS;
+}
+
+/*******************************************************************************
+ * Called on the warm boot path, once the calling cpu is coherent again, to
+ * clear any stale holding pen state. After the system power domain has been
+ * powered off, none of the other cpus can be in the pen either.
+ ******************************************************************************/
+void psci_pen_reset(const psci_power_state_t *state_info)
+{
+	unsigned int idx;
+
+	if (is_local_state_off(
+			state_info->pwr_domain_state[PLAT_MAX_PWR_LVL]) == 0) {
+		psci_set_pen_state(PSCI_PEN_NONE);
+		return;
+	}
+
+	for (idx = 0U; idx < psci_plat_core_count; idx++) {
+		psci_set_pen_state_by_idx(idx, PSCI_PEN_NONE);
+	}
+}
+#endif /* PSCI_EARLY_CPU_INIT || PSCI_CPU_OFF_TO_PEN */
+
 /*******************************************************************************
  * Generic handler which is called to physically power on a cpu identified by
  * its mpidr. It performs the generic, architectural, platform setup and state
@@ -62,6 +197,9 @@ int psci_cpu_on_start(u_register_t target_cpu,
 	int rc;
 	aff_info_state_t target_aff_state;
 	unsigned int target_idx = (unsigned int)plat_core_pos_by_mpidr(target_cpu);
+#if PSCI_EARLY_CPU_INIT || PSCI_CPU_OFF_TO_PEN
+	unsigned int wait_ms = PSCI_PEN_OFF_TIMEOUT_MS;
+#endif
 
 	/*
 	 * This function must only be called on platforms where the
@@ -70,6 +208,12 @@ int psci_cpu_on_start(u_register_t target_cpu,
 	assert((psci_plat_pm_ops->pwr_domain_on != NULL) &&
 	       (psci_plat_pm_ops->pwr_domain_on_finish != NULL));
 
+#if ENABLE_RUNTIME_INSTRUMENTATION
+	PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
+		RT_INSTR_ENTER_CPU_ON,
+		PMF_NO_CACHE_MAINT);
+#endif
+
 	/* Protect against multiple CPUs trying to turn ON the same target CPU */
 	psci_spin_lock_cpu(target_idx);
 
@@ -95,6 +239,36 @@ int psci_cpu_on_start(u_register_t target_cpu,
 	if (rc != PSCI_E_SUCCESS)
 		goto exit;
 
+#if PSCI_EARLY_CPU_INIT || PSCI_CPU_OFF_TO_PEN
+	/* Let a cpu asked to leave the holding pen finish powering down */
+	flush_cpu_data_by_index(target_idx, psci_svc_cpu_data.pen_state);
+	while ((psci_get_pen_state_by_idx(target_idx) == PSCI_PEN_OFF) &&
+	       (wait_ms != 0U)) {
+		mdelay(1U);
+		wait_ms--;
+		flush_cpu_data_by_index(target_idx,
+					psci_svc_cpu_data.pen_state);
+	}
+
+	if (psci_get_pen_state_by_idx(target_idx) == PSCI_PEN_OFF) {
+		ERROR("PSCI: Parked CPU %u failed to power down\n",
+		      target_idx);
+		rc = PSCI_E_INTERN_FAIL;
+		goto exit;
+	}
+#endif
+
+#if PSCI_EARLY_CPU_INIT
+	/*
+	 * A cpu which was powered up at cold boot but never reached the
+	 * holding pen cannot be powered on again. Leave it OFF.
+	 */
+	if (psci_get_pen_state_by_idx(target_idx) == PSCI_PEN_INIT) {
+		rc = PSCI_E_INTERN_FAIL;
+		goto exit;
+	}
+#endif
+
 	/*
 	 * Call the cpu on handler registered by the Secure Payload Dispatcher
 	 * to let it do any bookeeping. If the handler encounters an error, it's
@@ -129,6 +303,19 @@ int psci_cpu_on_start(u_register_t target_cpu,
 		       AFF_STATE_ON_PENDING);
 	}
 
+#if PSCI_EARLY_CPU_INIT || PSCI_CPU_OFF_TO_PEN
+	/*
+	 * A CPU parked in the EL3 holding pen is already powered up and
+	 * initialised, so only its entry point needs to be stored before it
+	 * is released.
+	 */
+	if (psci_get_pen_state_by_idx(target_idx) == PSCI_PEN_PARKED) {
+		cm_init_context_by_index(target_idx, ep);
+		psci_pen_release(target_idx);
+		goto exit;
+	}
+#endif
+
 	/*
 	 * Perform generic, architecture and platform specific handling.
 	 */
@@ -156,11 +343,11 @@ exit:
 }
 
 /*******************************************************************************
- * The following function finish an earlier power on request. They
- * are called by the common finisher routine in psci_common.c. The `state_info`
- * is the psci_power_state from which this CPU has woken up from.
+ * Platform and architectural part of the power on finisher. It brings the
+ * calling cpu to a state where it is coherent and ready to run in the
+ * non-secure address space.
  ******************************************************************************/
-void psci_cpu_on_finish(unsigned int cpu_idx, const psci_power_state_t *state_info)
+static void psci_cpu_on_finish_setup(const psci_power_state_t *state_info)
 {
 	/*
 	 * Plat. management: Perform the platform specific actions
@@ -191,7 +378,14 @@ void psci_cpu_on_finish(unsigned int cpu_idx, const psci_power_state_t *state_in
 	 * to run in the non-secure address space.
 	 */
 	psci_arch_setup();
+}
 
+/*******************************************************************************
+ * Generic part of the power on finisher, performed once the cpu_on_start()
+ * request for the calling cpu has completed.
+ ******************************************************************************/
+static void psci_cpu_on_finish_complete(unsigned int cpu_idx)
+{
 	/*
 	 * Lock the CPU spin lock to make sure that the context initialization
 	 * is done. Since the lock is only used in this function to create
@@ -218,3 +412,190 @@ void psci_cpu_on_finish(unsigned int cpu_idx, const psci_power_state_t *state_in
 	/* This needs to be done only once */
 	psci_cpu_pd_nodes[cpu_idx].mpidr = read_mpidr() & MPIDR_AFFINITY_MASK;
 }
+
+/*******************************************************************************
+ * The following function finish an earlier power on request. They
+ * are called by the common finisher routine in psci_common.c. The `state_info`
+ * is the psci_power_state from which this CPU has woken up from.
+ ******************************************************************************/
+void psci_cpu_on_finish(unsigned int cpu_idx, const psci_power_state_t *state_info)
+{
+	psci_cpu_on_finish_setup(state_info);
+	psci_cpu_on_finish_complete(cpu_idx);
+
+#if ENABLE_RUNTIME_INSTRUMENTATION
+	PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
+		RT_INSTR_EXIT_CPU_ON,
+		PMF_NO_CACHE_MAINT);
+#endif
+}
+
+#if PSCI_EARLY_CPU_INIT || PSCI_CPU_OFF_TO_PEN
+/*******************************************************************************
+ * Mark the calling cpu as parked in the EL3 holding pen and set its affinity
+ * info state to OFF. Both are updated under the cpu lock, so that a CPU_ON
+ * racing with this either finds the cpu ON or parked, and never tries to power
+ * up a cpu which is still running.
+ ******************************************************************************/
+void psci_pen_enter(void)
+{
+	unsigned int cpu_idx = plat_my_core_pos();
+
+	psci_spin_lock_cpu(cpu_idx);
+
+	psci_set_pen_state(PSCI_PEN_PARKED);
+	psci_flush_cpu_data(psci_svc_cpu_data.pen_state);
+
+	psci_set_aff_info_state(AFF_STATE_OFF);
+	psci_flush_cpu_data(psci_svc_cpu_data.aff_info_state);
+
+	psci_spin_unlock_cpu(cpu_idx);
+
+	dsbish();
+	sev();
+}
+
+/*******************************************************************************
+ * Wait in the EL3 holding pen, after psci_pen_enter(), until a CPU_ON request
+ * releases the calling cpu, then complete the power on request. The cpu is
+ * expected to be coherent and fully initialised. The cpu is powered down
+ * instead if psci_pen_power_down() asks it to.
+ ******************************************************************************/
+void psci_pen_wait(void)
+{
+	unsigned int cpu_idx = plat_my_core_pos();
+
+	while (psci_get_pen_state() == PSCI_PEN_PARKED) {
+		wfe();
+		dmbish();
+	}
+
+	/* Leave the pen to power down rather than to be turned on */
+	if (psci_get_pen_state() == PSCI_PEN_OFF) {
+		psci_pen_cpu_off();
+	}
+
+	dmbish();
+	assert(psci_get_pen_state() == PSCI_PEN_RELEASED);
+	psci_set_pen_state(PSCI_PEN_NONE);
+
+	psci_cpu_on_finish_complete(cpu_idx);
+
+	cm_prepare_el3_exit_ns();
+
+	psci_set_aff_info_state(AFF_STATE_ON);
+	psci_flush_cpu_data(psci_svc_cpu_data.aff_info_state);
+
+#if ENABLE_RUNTIME_INSTRUMENTATION
+	PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
+		RT_INSTR_EXIT_CPU_ON,
+		PMF_NO_CACHE_MAINT);
+#endif
+}
+#endif /* PSCI_EARLY_CPU_INIT || PSCI_CPU_OFF_TO_PEN */
+
+#if PSCI_EARLY_CPU_INIT
+/*******************************************************************************
+ * This function is called by a secondary cpu which has been released early
+ * during cold boot. It performs the per-cpu platform and architectural
+ * initialisation normally done when the cpu is first turned on, then waits
+ * in the EL3 holding pen until a CPU_ON request releases it. The cpu remains
+ * OFF as far as AFFINITY_INFO is concerned while it is parked.
+ ******************************************************************************/
+void psci_pen_entry(unsigned int cpu_idx)
+{
+	unsigned int end_pwrlvl = PLAT_MAX_PWR_LVL;
+	unsigned int parent_nodes[PLAT_MAX_PWR_LVL] = {0};
+	psci_power_state_t state_info = { {PSCI_LOCAL_STATE_RUN} };
+
+	psci_get_parent_pwr_domain_nodes(cpu_idx, end_pwrlvl, parent_nodes);
+	psci_acquire_pwr_domain_locks(end_pwrlvl, parent_nodes);
+	psci_get_target_local_pwr_states(end_pwrlvl, &state_info);
+
+	psci_cpu_on_finish_setup(&state_info);
+
+	/*
+	 * The cpu and its ancestors are physically running and must be taken
+	 * into account by state coordination, but the cpu has not been turned
+	 * on by the caller of PSCI yet.
+	 */
+	psci_set_pwr_domains_to_run(end_pwrlvl);
+
+	psci_release_pwr_domain_locks(end_pwrlvl, parent_nodes);
+
+	psci_pen_enter();
+	psci_pen_wait();
+}
+
+/*******************************************************************************
+ * Called by the primary cpu during cold boot, once PSCI has been set up, to
+ * power up all the secondary cpus. Each of them performs its per-cpu
+ * initialisation (errata workarounds, EL3 extensions, GIC redistributor
+ * and CPU interface) in parallel and then parks in the EL3 holding pen, from
+ * which a later CPU_ON only needs to release it.
+ ******************************************************************************/
+void psci_early_cpu_init(void)
+{
+	unsigned int idx, my_idx = plat_my_core_pos();
+	unsigned int count = 0U;
+	unsigned int wait_ms = PSCI_EARLY_CPU_INIT_TIMEOUT_MS;
+	u_register_t mpidr;
+
+	assert(psci_plat_pm_ops->pwr_domain_on != NULL);
+
+	for (idx = 0U; idx < psci_plat_core_count; idx++) {
+		if (idx == my_idx) {
+			continue;
+		}
+
+		mpidr = plat_core_pos_to_mpidr(idx);
+		if (mpidr == INVALID_MPID) {
+			continue;
+		}
+
+		/*
+		 * The target cpu reads its pen state with the caches off, so
+		 * make sure it reaches memory before it is powered up.
+		 */
+		psci_set_pen_state_by_idx(idx, PSCI_PEN_INIT);
+		flush_cpu_data_by_index(idx, psci_svc_cpu_data.pen_state);
+
+		if (psci_plat_pm_ops->pwr_domain_on(mpidr) != PSCI_E_SUCCESS) {
+			WARN("PSCI: Failed to power up CPU 0x%lx early\n",
+			     (unsigned long)mpidr);
+			psci_set_pen_state_by_idx(idx, PSCI_PEN_NONE);
+			flush_cpu_data_by_index(idx,
+						psci_svc_cpu_data.pen_state);
+			continue;
+		}
+
+		count++;
+	}
+
+	/* Wait for all the released cpus to reach the holding pen */
+	for (idx = 0U; idx < psci_plat_core_count; idx++) {
+		while ((psci_get_pen_state_by_idx(idx) == PSCI_PEN_INIT) &&
+		       (wait_ms != 0U)) {
+			mdelay(1U);
+			wait_ms--;
+		}
+
+		/*
+		 * A cpu which has not made it to the pen is left OFF. It
+		 * stays in the INIT state, so that CPU_ON requests for it are
+		 * refused until it eventually parks.
+		 */
+		if (psci_get_pen_state_by_idx(idx) == PSCI_PEN_INIT) {
+			ERROR("PSCI: CPU 0x%lx failed to reach the holding pen\n",
+			      (unsigned long)plat_core_pos_to_mpidr(idx));
+			count--;
+		}
+	}
+
+	if ((count == 0U) && (psci_plat_core_count > 1U)) {
+		WARN("PSCI: No secondary CPU could be powered up early\n");
+	}
+
+	INFO("PSCI: %u secondary CPUs initialised and parked\n", count);
+}
+#endif /* PSCI_EARLY_CPU_INIT */
@@ -103,6 +103,47 @@ static inline plat_local_state_t psci_get_cpu_local_state_by_idx(
 				     psci_svc_cpu_data.local_state);
 }
 
+#if PSCI_EARLY_CPU_INIT || PSCI_CPU_OFF_TO_PEN
+/*
+ * States of a CPU with respect to the EL3 holding pen:
+ * - NONE: the CPU goes through the regular CPU_ON path.
+ * - INIT: the CPU has been released during cold boot to run its per-CPU
+ *   initialisation and will park in the pen.
+ * - PARKED: the CPU is initialised and waiting in the pen for a CPU_ON,
+ *   either after its early initialisation or after a CPU_OFF.
+ * - RELEASED: a CPU_ON has been issued for the parked CPU.
+ * - OFF: the parked CPU has been asked to leave the pen and power down, so
+ *   that it no longer holds its ancestor power domains in the RUN state.
+ */
+#define PSCI_PEN_NONE		U(0)
+#define PSCI_PEN_INIT		U(1)
+#define PSCI_PEN_PARKED		U(2)
+#define PSCI_PEN_RELEASED	U(3)
+#define PSCI_PEN_OFF		U(4)
+
+static inline void psci_set_pen_state(unsigned int state)
+{
+	set_cpu_data(psci_svc_cpu_data.pen_state, (uint8_t)state);
+}
+
+static inline unsigned int psci_get_pen_state(void)
+{
+	return get_cpu_data(psci_svc_cpu_data.pen_state);
+}
+
+static inline void psci_set_pen_state_by_idx(unsigned int idx,
+					     unsigned int state)
+{
+	set_cpu_data_by_index(idx, psci_svc_cpu_data.pen_state,
+			      (uint8_t)state);
+}
+
+static inline unsigned int psci_get_pen_state_by_idx(unsigned int idx)
+{
+	return get_cpu_data_by_index(idx, psci_svc_cpu_data.pen_state);
+}
+#endif /* PSCI_EARLY_CPU_INIT || PSCI_CPU_OFF_TO_PEN */
+
 /* Helper function to identify a CPU standby request in PSCI Suspend call */
 static inline bool is_cpu_standby_req(unsigned int is_power_down_state,
 				      unsigned int retn_lvl)
@@ -161,7 +202,14 @@ typedef struct cpu_pwr_domain_node {
 	 * when multiple CPUs try to turn ON the same target CPU.
 	 */
 	spinlock_t cpu_lock;
-} cpu_pd_node_t;
+} __aligned(CACHE_WRITEBACK_GRANULE) cpu_pd_node_t;
+
+/*
+ * The CPU power domain nodes are read on every power management operation
+ * and their lock is taken by CPU_ON, keep them on separate cache lines.
+ */
+CASSERT((sizeof(cpu_pd_node_t) % CACHE_WRITEBACK_GRANULE) == 0U,
+	assert_cpu_pd_node_not_cache_line_padded);
 
 #if PSCI_OS_INIT_MODE
 /*******************************************************************************
@@ -338,15 +386,28 @@ int psci_cpu_on_start(u_register_t target_cpu,
 		      const entry_point_info_t *ep);
 
 void psci_cpu_on_finish(unsigned int cpu_idx, const psci_power_state_t *state_info);
+#if PSCI_EARLY_CPU_INIT
+void psci_pen_entry(unsigned int cpu_idx);
+#endif
+#if PSCI_EARLY_CPU_INIT || PSCI_CPU_OFF_TO_PEN
+void psci_pen_enter(void);
+void psci_pen_wait(void);
+int psci_pen_power_down(unsigned int end_pwrlvl);
+void psci_pen_reset(const psci_power_state_t *state_info);
+#endif
 
 /* Private exported functions from psci_off.c */
 int psci_do_cpu_off(unsigned int end_pwrlvl);
+#if PSCI_EARLY_CPU_INIT || PSCI_CPU_OFF_TO_PEN
+void __dead2 psci_pen_cpu_off(void);
+#endif
 
 /* Private exported functions from psci_suspend.c */
 int psci_cpu_suspend_start(const entry_point_info_t *ep,
 			   unsigned int end_pwrlvl,
 			   psci_power_state_t *state_info,
-			   unsigned int is_power_down_state);
+			   unsigned int is_power_down_state,
+			   bool is_sys_suspend);
 
 void psci_cpu_suspend_finish(unsigned int cpu_idx, const psci_power_state_t *state_info);
 
@@ -368,6 +429,10 @@ u_register_t psci_stat_residency(u_register_t target_cpu,
 			unsigned int power_state);
 u_register_t psci_stat_count(u_register_t target_cpu,
 			unsigned int power_state);
+#if PSCI_IDLE_GOVERNOR
+void psci_idle_governor(unsigned int end_pwrlvl,
+			psci_power_state_t *state_info);
+#endif
 
 /* Private exported functions from psci_mem_protect.c */
 u_register_t psci_mem_protect(unsigned int enable);
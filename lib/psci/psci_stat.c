@@ -1,14 +1,17 @@
 /*
- * Copyright (c) 2016-2019, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2023, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <assert.h>
+#include <string.h>
 
 #include <platform_def.h>
 
+#include <arch_helpers.h>
 #include <common/debug.h>
+#include <lib/psci/psci_stat_snapshot.h>
 #include <plat/common/platform.h>
 
 #include "psci_private.h"
@@ -39,6 +42,54 @@ static psci_stat_t psci_cpu_stat[PLATFORM_CORE_COUNT]
 static psci_stat_t psci_non_cpu_stat[PSCI_NUM_NON_CPU_PWR_DOMAINS]
 				[PLAT_MAX_PWR_LVL_STATES];
 
+#if PSCI_STAT_SNAPSHOT
+/*
+ * Sequence counters of the stats of each CPU and non CPU power domain. A
+ * counter is odd while the stats of its power domain are being updated, which
+ * allows psci_stat_snapshot() to read consistent values without taking the
+ * power domain locks.
+ */
+static unsigned int psci_cpu_stat_seq[PLATFORM_CORE_COUNT];
+static unsigned int psci_non_cpu_stat_seq[PSCI_NUM_NON_CPU_PWR_DOMAINS];
+
+static inline void stat_write_begin(unsigned int *seq)
+{
+	*(volatile unsigned int *)seq = *seq + 1U;
+	dmbst();
+}
+
+static inline void stat_write_end(unsigned int *seq)
+{
+	dmbst();
+	*(volatile unsigned int *)seq = *seq + 1U;
+}
+#else
+#define stat_write_begin(_seq)
+#define stat_write_end(_seq)
+#endif
+
+#if PSCI_IDLE_GOVERNOR
+/*
+ * Weight of the latest residency sample in the predicted residency, expressed
+ * as a shift: pred += (sample - pred) / 2^IDLE_GOV_PRED_SHIFT.
+ */
+#define IDLE_GOV_PRED_SHIFT		3U
+
+/*
+ * Predicted idle residency in microseconds of each non CPU power domain. A
+ * value of 0 means that no residency has been observed yet. Accesses are
+ * serialised by the power domain locks.
+ */
+static u_register_t idle_gov_pred[PSCI_NUM_NON_CPU_PWR_DOMAINS];
+
+/* Number of times the idle governor demoted each non CPU local state */
+static u_register_t idle_gov_demotions[PSCI_NUM_NON_CPU_PWR_DOMAINS]
+				[PLAT_MAX_PWR_LVL_STATES];
+
+/* Highest power level demoted on the last suspend of each CPU, 0 if none */
+static unsigned int idle_gov_demoted_lvl[PLATFORM_CORE_COUNT];
+#endif
+
 /*
  * This functions returns the index into the `psci_stat_t` array given the
  * local power state and power domain level. If the platform implements the
@@ -62,6 +113,111 @@ static int get_stat_idx(plat_local_state_t local_state, unsigned int pwr_lvl)
 	return idx;
 }
 
+#if PSCI_IDLE_GOVERNOR
+/*
+ * Fold a residency sample into the predicted residency of a non CPU power
+ * domain.
+ */
+static void idle_gov_update_pred(unsigned int parent_idx,
+				 u_register_t residency)
+{
+	u_register_t pred = idle_gov_pred[parent_idx];
+
+	if (pred == 0U)
+		pred = residency;
+	else if (residency >= pred)
+		pred += (residency - pred) >> IDLE_GOV_PRED_SHIFT;
+	else
+		pred -= (pred - residency) >> IDLE_GOV_PRED_SHIFT;
+
+	/* 0 is reserved to mean that there is no history */
+	idle_gov_pred[parent_idx] = (pred == 0U) ? 1U : pred;
+}
+
+/*******************************************************************************
+ * This function is called by a CPU about to suspend, with the negotiated
+ * target states in `state_info` and the locks held for each level till
+ * `end_pwrlvl`. Starting from the highest level, the non CPU power domains
+ * whose predicted residency is below the target residency of their negotiated
+ * local state are kept running, as entering and exiting that state would cost
+ * more than it saves. The demotion stops at the first state which pays off,
+ * since the power domains below it have to be powered down as well.
+ *
+ * Nothing is demoted until a residency has been observed for a power domain,
+ * or if the platform does not describe the local state.
+ ******************************************************************************/
+void psci_idle_governor(unsigned int end_pwrlvl,
+			psci_power_state_t *state_info)
+{
+	unsigned int lvl, parent_idx;
+	unsigned int cpu_idx = plat_my_core_pos();
+	unsigned int parent_nodes[PLAT_MAX_PWR_LVL] = {0};
+	plat_local_state_t local_state;
+	psci_idle_state_params_t params;
+	u_register_t target;
+
+	assert(end_pwrlvl <= PLAT_MAX_PWR_LVL);
+	assert(state_info != NULL);
+
+	idle_gov_demoted_lvl[cpu_idx] = 0U;
+
+	if (psci_plat_pm_ops->get_idle_state_params == NULL)
+		return;
+
+	psci_get_parent_pwr_domain_nodes(cpu_idx, end_pwrlvl, parent_nodes);
+
+	for (lvl = end_pwrlvl; lvl > PSCI_CPU_PWR_LVL; lvl--) {
+		local_state = state_info->pwr_domain_state[lvl];
+		if (is_local_state_run(local_state) != 0)
+			continue;
+
+		parent_idx = parent_nodes[lvl - 1U];
+		if (idle_gov_pred[parent_idx] == 0U)
+			break;
+
+		if (psci_plat_pm_ops->get_idle_state_params(lvl, local_state,
+							    &params) != 0)
+			break;
+
+		/* The residency must at least cover the transitions */
+		target = (u_register_t)params.entry_latency_us +
+			 params.exit_latency_us;
+		if (target < params.target_residency_us)
+			target = params.target_residency_us;
+
+		if (idle_gov_pred[parent_idx] >= target)
+			break;
+
+		state_info->pwr_domain_state[lvl] = PSCI_LOCAL_STATE_RUN;
+		idle_gov_demotions[parent_idx][get_stat_idx(local_state,
+							    lvl)]++;
+
+		if (idle_gov_demoted_lvl[cpu_idx] == 0U)
+			idle_gov_demoted_lvl[cpu_idx] = lvl;
+	}
+}
+
+/*
+ * The power domains kept running by the idle governor were idle for at most
+ * the residency of the CPU which demoted them. Use it as a sample so that the
+ * prediction recovers when the idle periods get longer.
+ */
+static void idle_gov_update_demoted(unsigned int cpu_idx,
+				    u_register_t residency)
+{
+	unsigned int lvl;
+	unsigned int parent_idx = psci_cpu_pd_nodes[cpu_idx].parent_node;
+
+	for (lvl = PSCI_CPU_PWR_LVL + 1U;
+	     lvl <= idle_gov_demoted_lvl[cpu_idx]; lvl++) {
+		idle_gov_update_pred(parent_idx, residency);
+		parent_idx = psci_non_cpu_pd_nodes[parent_idx].parent_node;
+	}
+
+	idle_gov_demoted_lvl[cpu_idx] = 0U;
+}
+#endif /* PSCI_IDLE_GOVERNOR */
+
 /*******************************************************************************
  * This function is passed the target local power states for each power
  * domain (state_info) between the current CPU domain and its ancestors until
@@ -127,8 +283,14 @@ void psci_stats_update_pwr_up(unsigned int end_pwrlvl,
 	    state_info, cpu_idx);
 
 	/* Update CPU stats. */
+	stat_write_begin(&psci_cpu_stat_seq[cpu_idx]);
 	psci_cpu_stat[cpu_idx][stat_idx].residency += residency;
 	psci_cpu_stat[cpu_idx][stat_idx].count++;
+	stat_write_end(&psci_cpu_stat_seq[cpu_idx]);
+
+#if PSCI_IDLE_GOVERNOR
+	idle_gov_update_demoted(cpu_idx, residency);
+#endif
 
 	/*
 	 * Check what power domains above CPU were off
@@ -159,8 +321,14 @@ void psci_stats_update_pwr_up(unsigned int end_pwrlvl,
 		stat_idx = get_stat_idx(local_state, lvl);
 
 		/* Update non cpu stats */
+		stat_write_begin(&psci_non_cpu_stat_seq[parent_idx]);
 		psci_non_cpu_stat[parent_idx][stat_idx].residency += residency;
 		psci_non_cpu_stat[parent_idx][stat_idx].count++;
+		stat_write_end(&psci_non_cpu_stat_seq[parent_idx]);
+
+#if PSCI_IDLE_GOVERNOR
+		idle_gov_update_pred(parent_idx, residency);
+#endif
 
 		parent_idx = psci_non_cpu_pd_nodes[parent_idx].parent_node;
 	}
@@ -256,3 +424,115 @@ u_register_t psci_stat_count(u_register_t target_cpu,
 	else
 		return 0;
 }
+
+#if PSCI_STAT_SNAPSHOT
+/* Size of the record of one power domain in a snapshot */
+#define SNAPSHOT_REC_SIZE	(sizeof(psci_stat_snapshot_pd_t) +	\
+		(PLAT_MAX_PWR_LVL_STATES * sizeof(psci_stat_snapshot_entry_t)))
+
+/*
+ * Copy the stats of a power domain into `dst`, retrying until no update was
+ * in progress or happened during the copy.
+ */
+static void stat_read(const unsigned int *seq, const psci_stat_t *stat,
+		      psci_stat_snapshot_entry_t *dst)
+{
+	unsigned int start, i;
+
+	for (;;) {
+		start = *(const volatile unsigned int *)seq;
+		if ((start & 1U) != 0U)
+			continue;
+
+		dmbld();
+
+		for (i = 0U; i < PLAT_MAX_PWR_LVL_STATES; i++) {
+			dst[i].residency = stat[i].residency;
+			dst[i].count = stat[i].count;
+			dst[i].demotions = 0U;
+		}
+
+		dmbld();
+
+		if (*(const volatile unsigned int *)seq == start)
+			break;
+	}
+}
+
+#if PSCI_IDLE_GOVERNOR
+/*
+ * Copy the idle governor demotion counts of a non CPU power domain into `dst`.
+ * Each count is a single word only ever incremented, so no retry is needed.
+ */
+static void demotions_read(const u_register_t *demotions,
+			   psci_stat_snapshot_entry_t *dst)
+{
+	unsigned int i;
+
+	for (i = 0U; i < PLAT_MAX_PWR_LVL_STATES; i++)
+		dst[i].demotions = *(const volatile u_register_t *)&demotions[i];
+}
+#endif
+
+/* Return the size of a snapshot of the stats of all the power domains */
+size_t psci_stat_snapshot_size(void)
+{
+	return sizeof(psci_stat_snapshot_hdr_t) +
+		((PLATFORM_CORE_COUNT + PSCI_NUM_NON_CPU_PWR_DOMAINS) *
+		 SNAPSHOT_REC_SIZE);
+}
+
+/*******************************************************************************
+ * This function copies the residency and count statistics of all the CPU and
+ * non CPU power domains into `buf`. It does not take the power domain locks
+ * so it neither waits for nor delays the power management operations in
+ * progress. The stats of each power domain are consistent but, as with a
+ * sequence of PSCI_STAT_RESIDENCY and PSCI_STAT_COUNT calls, different power
+ * domains may be sampled at slightly different times.
+ ******************************************************************************/
+int psci_stat_snapshot(void *buf, size_t size)
+{
+	psci_stat_snapshot_hdr_t *hdr = buf;
+	uint8_t *rec = (uint8_t *)buf + sizeof(*hdr);
+	psci_stat_snapshot_pd_t pd;
+	unsigned int i;
+
+	if ((buf == NULL) || (size < psci_stat_snapshot_size()))
+		return PSCI_E_INVALID_PARAMS;
+
+	hdr->version = PSCI_STAT_SNAPSHOT_VERSION;
+	hdr->num_pwr_domains = PLATFORM_CORE_COUNT +
+			       PSCI_NUM_NON_CPU_PWR_DOMAINS;
+	hdr->num_states = PLAT_MAX_PWR_LVL_STATES;
+	hdr->rec_size = (uint32_t)SNAPSHOT_REC_SIZE;
+	hdr->timestamp = read_cntpct_el0();
+
+	pd.pwr_lvl = PSCI_CPU_PWR_LVL;
+	pd.ncpus = 1U;
+	pd.reserved = 0U;
+
+	for (i = 0U; i < PLATFORM_CORE_COUNT; i++) {
+		pd.cpu_start_idx = i;
+		(void)memcpy(rec, &pd, sizeof(pd));
+		stat_read(&psci_cpu_stat_seq[i], psci_cpu_stat[i],
+			  (psci_stat_snapshot_entry_t *)(rec + sizeof(pd)));
+		rec += SNAPSHOT_REC_SIZE;
+	}
+
+	for (i = 0U; i < PSCI_NUM_NON_CPU_PWR_DOMAINS; i++) {
+		pd.pwr_lvl = psci_non_cpu_pd_nodes[i].level;
+		pd.cpu_start_idx = psci_non_cpu_pd_nodes[i].cpu_start_idx;
+		pd.ncpus = psci_non_cpu_pd_nodes[i].ncpus;
+		(void)memcpy(rec, &pd, sizeof(pd));
+		stat_read(&psci_non_cpu_stat_seq[i], psci_non_cpu_stat[i],
+			  (psci_stat_snapshot_entry_t *)(rec + sizeof(pd)));
+#if PSCI_IDLE_GOVERNOR
+		demotions_read(idle_gov_demotions[i],
+			       (psci_stat_snapshot_entry_t *)(rec + sizeof(pd)));
+#endif
+		rec += SNAPSHOT_REC_SIZE;
+	}
+
+	return PSCI_E_SUCCESS;
+}
+#endif /* PSCI_STAT_SNAPSHOT */
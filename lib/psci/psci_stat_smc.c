@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2023, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdint.h>
+
+#include <common/debug.h>
+#include <common/runtime_svc.h>
+#include <lib/psci/psci.h>
+#include <lib/psci/psci_stat_snapshot.h>
+#include <lib/spinlock.h>
+#include <lib/xlat_tables/xlat_tables_v2.h>
+#include <smccc_helpers.h>
+
+#if !PLAT_XLAT_TABLES_DYNAMIC
+#error "PSCI_STAT_SNAPSHOT requires PLAT_XLAT_TABLES_DYNAMIC to be defined for BL31"
+#endif
+
+/*
+ * The Non-secure buffer is mapped on first use and stays mapped while the
+ * caller keeps passing the same buffer, so that sampling the statistics does
+ * not require any change to the translation tables.
+ */
+static unsigned long long snapshot_buf_pa;
+static uintptr_t snapshot_buf_va;
+static size_t snapshot_buf_size;
+
+/* Protects the mapping of the Non-secure buffer */
+static spinlock_t snapshot_lock;
+
+static int snapshot_map_buf(unsigned long long pa, size_t size)
+{
+	uintptr_t va;
+	int rc;
+
+	if ((snapshot_buf_va != 0U) && (snapshot_buf_pa == pa) &&
+	    (snapshot_buf_size >= size)) {
+		return 0;
+	}
+
+	if (snapshot_buf_va != 0U) {
+		rc = mmap_remove_dynamic_region(snapshot_buf_va,
+						snapshot_buf_size);
+		if (rc != 0) {
+			return rc;
+		}
+		snapshot_buf_va = 0U;
+	}
+
+	size = round_up(size, PAGE_SIZE);
+
+	rc = mmap_add_dynamic_region_alloc_va(pa, &va, size,
+			MT_MEMORY | MT_RW | MT_NS | MT_EXECUTE_NEVER);
+	if (rc != 0) {
+		return rc;
+	}
+
+	snapshot_buf_pa = pa;
+	snapshot_buf_va = va;
+	snapshot_buf_size = size;
+
+	return 0;
+}
+
+/*
+ * This function handles the SMC calls copying a snapshot of the PSCI
+ * statistics into a Non-secure buffer.
+ */
+uintptr_t psci_stat_snapshot_smc_handler(unsigned int smc_fid,
+					 u_register_t x1,
+					 u_register_t x2,
+					 u_register_t x3,
+					 u_register_t x4,
+					 void *cookie,
+					 void *handle,
+					 u_register_t flags)
+{
+	size_t size = psci_stat_snapshot_size();
+	int rc;
+
+	/* Allow calls from non-secure only */
+	if (is_caller_secure(flags)) {
+		SMC_RET1(handle, PSCI_E_DENIED);
+	}
+
+	if ((smc_fid != PSCI_STAT_SNAPSHOT_SMC_32) &&
+	    (smc_fid != PSCI_STAT_SNAPSHOT_SMC_64)) {
+		WARN("Unimplemented PSCI stat Call: 0x%x\n", smc_fid);
+		SMC_RET1(handle, SMC_UNK);
+	}
+
+	/* Truncate parameters if 32b SMC convention call */
+	if (GET_SMC_CC(smc_fid) == SMC_32) {
+		x1 = (uint32_t)x1;
+		x2 = (uint32_t)x2;
+	}
+
+	if (x2 < size) {
+		SMC_RET2(handle, PSCI_E_INVALID_PARAMS, size);
+	}
+
+	if ((x1 == 0U) || ((x1 & PAGE_SIZE_MASK) != 0U)) {
+		SMC_RET2(handle, PSCI_E_INVALID_ADDRESS, size);
+	}
+
+	/*
+	 * The buffer is mapped as Non-secure, so the caller can only get
+	 * Non-secure memory to be written.
+	 */
+	spin_lock(&snapshot_lock);
+
+	if (snapshot_map_buf(x1, size) != 0) {
+		spin_unlock(&snapshot_lock);
+		SMC_RET2(handle, PSCI_E_INVALID_ADDRESS, size);
+	}
+
+	rc = psci_stat_snapshot((void *)snapshot_buf_va, size);
+
+	spin_unlock(&snapshot_lock);
+
+	SMC_RET2(handle, rc, size);
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2022, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2023, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -11,6 +11,7 @@
 #include <arch_helpers.h>
 #include <common/bl_common.h>
 #include <common/debug.h>
+#include <drivers/console_ring.h>
 #include <context.h>
 #include <lib/el3_runtime/context_mgmt.h>
 #include <lib/el3_runtime/cpu_data.h>
@@ -158,11 +159,15 @@ static void psci_suspend_to_pwrdown_start(unsigned int end_pwrlvl,
  * All the required parameter checks are performed at the beginning and after
  * the state transition has been done, no further error is expected and it is
  * not possible to undo any of the actions taken beyond that point.
+ *
+ * `is_sys_suspend` is true for a SYSTEM_SUSPEND request, which the idle
+ * governor must not demote.
  ******************************************************************************/
 int psci_cpu_suspend_start(const entry_point_info_t *ep,
 			   unsigned int end_pwrlvl,
 			   psci_power_state_t *state_info,
-			   unsigned int is_power_down_state)
+			   unsigned int is_power_down_state,
+			   bool is_sys_suspend)
 {
 	int rc = PSCI_E_SUCCESS;
 	bool skip_wfi = false;
@@ -176,6 +181,14 @@ int psci_cpu_suspend_start(const entry_point_info_t *ep,
 	assert((psci_plat_pm_ops->pwr_domain_suspend != NULL) &&
 	       (psci_plat_pm_ops->pwr_domain_suspend_finish != NULL));
 
+	/*
+	 * Use the time the CPU would spend powered down to write out the
+	 * console rings. This is not worth it for a retention state.
+	 */
+	if ((is_power_down_state != 0U) && console_ring_pending()) {
+		console_ring_drain(false);
+	}
+
 	/* Get the parent nodes */
 	psci_get_parent_pwr_domain_nodes(idx, end_pwrlvl, parent_nodes);
 
@@ -215,6 +228,16 @@ int psci_cpu_suspend_start(const entry_point_info_t *ep,
 		 * the end level specified.
 		 */
 		psci_do_state_coordination(end_pwrlvl, state_info);
+
+#if PSCI_IDLE_GOVERNOR
+		/*
+		 * Keep running the power domains which are not expected to
+		 * stay idle long enough for the negotiated state to pay off.
+		 * An explicit SYSTEM_SUSPEND request is never demoted.
+		 */
+		if (!is_sys_suspend)
+			psci_idle_governor(end_pwrlvl, state_info);
+#endif
 #if PSCI_OS_INIT_MODE
 	}
 #endif
@@ -119,6 +119,17 @@ void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime)
 	}
 }
 
+void xlat_arch_tlbi_va_range(uintptr_t va, size_t size, int xlat_regime)
+{
+	assert(IS_PAGE_ALIGNED(va));
+	assert((size % PAGE_SIZE) == 0U);
+
+	/* There are no TLBI range operations in AArch32 */
+	for (; size > 0U; size -= PAGE_SIZE, va += PAGE_SIZE) {
+		xlat_arch_tlbi_va(va, xlat_regime);
+	}
+}
+
 void xlat_arch_tlbi_va_sync(void)
 {
 	/* Invalidate all entries from branch predictors. */
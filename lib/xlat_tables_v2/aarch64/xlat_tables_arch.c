@@ -211,6 +211,82 @@ void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime)
 	}
 }
 
+/*
+ * Issue a single TLBI range operation for the translation regime. The operand
+ * must have been built as described in the TLBIR_* definitions.
+ */
+static void xlat_arch_tlbi_rva(uint64_t operand, int xlat_regime)
+{
+	if (xlat_regime == EL1_EL0_REGIME) {
+		tlbirvaae1is(operand);
+	} else if (xlat_regime == EL2_REGIME) {
+		tlbirvae2is(operand);
+	} else {
+		tlbirvae3is(operand);
+	}
+}
+
+void xlat_arch_tlbi_va_range(uintptr_t va, size_t size, int xlat_regime)
+{
+	unsigned long long pages = size >> PAGE_SIZE_SHIFT;
+	unsigned long long chunk;
+	unsigned int scale, num;
+
+	assert(IS_PAGE_ALIGNED(va));
+	assert((size % PAGE_SIZE) == 0U);
+
+	if (!is_feat_tlbirange_present()) {
+		for (; pages > 0ULL; pages--, va += PAGE_SIZE) {
+			xlat_arch_tlbi_va(va, xlat_regime);
+		}
+		return;
+	}
+
+	/* Same checks and barrier as in xlat_arch_tlbi_va() */
+	if (xlat_regime == EL1_EL0_REGIME) {
+		assert(xlat_arch_current_el() >= 1U);
+	} else if (xlat_regime == EL2_REGIME) {
+		assert(xlat_arch_current_el() >= 2U);
+	} else {
+		assert(xlat_regime == EL3_REGIME);
+		assert(xlat_arch_current_el() >= 3U);
+	}
+
+	dsbishst();
+
+	/*
+	 * A range operation covers an even number of pages, so a single page
+	 * left over is invalidated on its own. Otherwise, use the largest
+	 * scale that fits the remaining number of pages.
+	 */
+	while (pages > 0ULL) {
+		if ((pages % 2ULL) != 0ULL) {
+			xlat_arch_tlbi_va(va, xlat_regime);
+			va += PAGE_SIZE;
+			pages--;
+			continue;
+		}
+
+		scale = TLBIR_SCALE_MAX;
+		while ((pages >> ((5U * scale) + 1U)) == 0ULL) {
+			scale--;
+		}
+
+		num = (unsigned int)MIN(pages >> ((5U * scale) + 1U),
+				(unsigned long long)TLBIR_NUM_MAX + 1ULL) - 1U;
+		chunk = ((unsigned long long)num + 1ULL) << ((5U * scale) + 1U);
+
+		xlat_arch_tlbi_rva((TLBIR_TG_4K << TLBIR_TG_SHIFT) |
+			((uint64_t)scale << TLBIR_SCALE_SHIFT) |
+			((uint64_t)num << TLBIR_NUM_SHIFT) |
+			(((uint64_t)va >> PAGE_SIZE_SHIFT) & TLBIR_BADDR_MASK),
+			xlat_regime);
+
+		va += (uintptr_t)(chunk << PAGE_SIZE_SHIFT);
+		pages -= chunk;
+	}
+}
+
 void xlat_arch_tlbi_va_sync(void)
 {
 	/*
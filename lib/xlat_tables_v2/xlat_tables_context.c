@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2020, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2023, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -21,12 +21,69 @@
  */
 uint64_t mmu_cfg_params[MMU_CFG_PARAM_MAX];
 
+/*
+ * With XLAT_TABLES_PREBUILT, the translation tables of BL31 and BL2 are
+ * generated when the image is linked. They are placed with their description
+ * in .data, so that they are loaded with the image.
+ */
+#if XLAT_TABLES_PREBUILT && (defined(IMAGE_BL31) || defined(IMAGE_BL2))
+#define XLAT_PREBUILT_TF	1
+#else
+#define XLAT_PREBUILT_TF	0
+#endif
+
 /*
  * Allocate and initialise the default translation context for the BL image
  * currently executing.
  */
+#if XLAT_PREBUILT_TF
+#if PLAT_RO_XLAT_TABLES
+#error "XLAT_TABLES_PREBUILT is not compatible with PLAT_RO_XLAT_TABLES"
+#endif
+CASSERT(PAGE_SIZE == PAGE_SIZE_4KB, assert_xlat_prebuilt_granule_size);
+
+REGISTER_XLAT_CONTEXT_FULL_SPEC(tf, MAX_MMAP_REGIONS, MAX_XLAT_TABLES,
+				PLAT_VIRT_ADDR_SPACE_SIZE,
+				PLAT_PHY_ADDR_SPACE_SIZE, EL_REGIME_INVALID,
+				".data.xlat_prebuilt", ".data.xlat_prebuilt");
+
+/* Defined by the platform, see XLAT_PREBUILT_MMAP() */
+#pragma weak xlat_prebuilt_mmap
+extern const xlat_prebuilt_mmap_t xlat_prebuilt_mmap;
+
+#if defined(IMAGE_BL31) || BL2_RUNS_AT_EL3
+#define XLAT_PREBUILT_TF_REGIME		EL3_REGIME
+#else
+#define XLAT_PREBUILT_TF_REGIME		EL1_EL0_REGIME
+#endif
+
+#if PLAT_XLAT_TABLES_DYNAMIC
+#define XLAT_PREBUILT_TF_DYNAMIC	XLAT_PREBUILT_FLAG_DYNAMIC
+#else
+#define XLAT_PREBUILT_TF_DYNAMIC	0U
+#endif
+
+/* Completed by tools/xlat_prebuilt, which finds it by its symbol name. */
+xlat_prebuilt_info_t tf_xlat_prebuilt __section(".data.xlat_prebuilt") = {
+	.version = XLAT_PREBUILT_VERSION,
+	.xlat_regime = XLAT_PREBUILT_TF_REGIME,
+	.flags = (ENABLE_BTI ? XLAT_PREBUILT_FLAG_BTI : 0U) |
+		 (ENABLE_RME ? XLAT_PREBUILT_FLAG_RME : 0U) |
+		 XLAT_PREBUILT_TF_DYNAMIC,
+	.pa_max_address = PLAT_PHY_ADDR_SPACE_SIZE - 1ULL,
+	.va_max_address = PLAT_VIRT_ADDR_SPACE_SIZE - 1ULL,
+	.base_level = GET_XLAT_TABLE_LEVEL_BASE(PLAT_VIRT_ADDR_SPACE_SIZE),
+	.base_table = (uintptr_t)tf_base_xlat_table,
+	.base_table_entries = ARRAY_SIZE(tf_base_xlat_table),
+	.tables = (uintptr_t)tf_xlat_tables,
+	.tables_num = MAX_XLAT_TABLES,
+	.mmap_num = MAX_MMAP_REGIONS,
+	.manifest = (uintptr_t)&xlat_prebuilt_mmap,
+};
+#else
 REGISTER_XLAT_CONTEXT(tf, MAX_MMAP_REGIONS, MAX_XLAT_TABLES,
 		      PLAT_VIRT_ADDR_SPACE_SIZE, PLAT_PHY_ADDR_SPACE_SIZE);
+#endif /* XLAT_PREBUILT_TF */
 
 void mmap_add_region(unsigned long long base_pa, uintptr_t base_va, size_t size,
 		     unsigned int attr)
@@ -107,6 +164,17 @@ void __init init_xlat_tables(void)
 		tf_xlat_ctx.xlat_regime = EL3_REGIME;
 	}
 
+#if XLAT_PREBUILT_TF
+	/*
+	 * tf_xlat_prebuilt is written once the image is linked. Hide it from the
+	 * compiler so that the initial value of its fields isn't propagated.
+	 */
+	const xlat_prebuilt_info_t *prebuilt = &tf_xlat_prebuilt;
+
+	__asm__ ("" : "+r" (prebuilt));
+	if (install_prebuilt_xlat_tables_ctx(&tf_xlat_ctx, prebuilt))
+		return;
+#endif
 	init_xlat_tables_ctx(&tf_xlat_ctx);
 }
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2021, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2023, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -28,6 +28,13 @@ static inline __attribute__((unused)) void xlat_clean_dcache_range(uintptr_t add
 		clean_dcache_range(addr, size);
 }
 
+/* Helper function that fills a translation table with invalid descriptors. */
+static void xlat_table_zero(uint64_t *table)
+{
+	for (unsigned int i = 0U; i < XLAT_TABLE_ENTRIES; i++)
+		table[i] = INVALID_DESC;
+}
+
 #if PLAT_XLAT_TABLES_DYNAMIC
 
 /*
@@ -55,12 +62,18 @@ static int xlat_table_get_index(const xlat_ctx_t *ctx, const uint64_t *table)
 	return -1;
 }
 
-/* Returns a pointer to an empty translation table. */
+/*
+ * Returns a pointer to an empty translation table. Tables are only zeroed when
+ * they are handed out, so that unused tables are never written.
+ */
 static uint64_t *xlat_table_get_empty(const xlat_ctx_t *ctx)
 {
-	for (int i = 0; i < ctx->tables_num; i++)
-		if (ctx->tables_mapped_regions[i] == 0)
+	for (int i = 0; i < ctx->tables_num; i++) {
+		if (ctx->tables_mapped_regions[i] == 0) {
+			xlat_table_zero(ctx->tables[i]);
 			return ctx->tables[i];
+		}
+	}
 
 	return NULL;
 }
@@ -91,11 +104,16 @@ static bool xlat_table_is_empty(const xlat_ctx_t *ctx, const uint64_t *table)
 
 #else /* PLAT_XLAT_TABLES_DYNAMIC */
 
-/* Returns a pointer to the first empty translation table. */
+/*
+ * Returns a pointer to the first empty translation table. Tables are only
+ * zeroed when they are handed out, so that unused tables are never written.
+ */
 static uint64_t *xlat_table_get_empty(xlat_ctx_t *ctx)
 {
 	assert(ctx->next_table < ctx->tables_num);
 
+	xlat_table_zero(ctx->tables[ctx->next_table]);
+
 	return ctx->tables[ctx->next_table++];
 }
 
@@ -627,8 +645,13 @@ static uintptr_t xlat_tables_map_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 					       subtable, XLAT_TABLE_ENTRIES,
 					       level + 1U);
 #if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
-			xlat_clean_dcache_range((uintptr_t)subtable,
-				XLAT_TABLE_ENTRIES * sizeof(uint64_t));
+			/*
+			 * During initialisation, all tables are cleaned once
+			 * all the regions have been mapped.
+			 */
+			if (ctx->initialized)
+				xlat_clean_dcache_range((uintptr_t)subtable,
+					XLAT_TABLE_ENTRIES * sizeof(uint64_t));
 #endif
 			if (end_va !=
 				(table_idx_va + XLAT_BLOCK_SIZE(level) - 1U))
@@ -643,8 +666,13 @@ static uintptr_t xlat_tables_map_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 					       subtable, XLAT_TABLE_ENTRIES,
 					       level + 1U);
 #if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
-			xlat_clean_dcache_range((uintptr_t)subtable,
-				XLAT_TABLE_ENTRIES * sizeof(uint64_t));
+			/*
+			 * During initialisation, all tables are cleaned once
+			 * all the regions have been mapped.
+			 */
+			if (ctx->initialized)
+				xlat_clean_dcache_range((uintptr_t)subtable,
+					XLAT_TABLE_ENTRIES * sizeof(uint64_t));
 #endif
 			if (end_va !=
 				(table_idx_va + XLAT_BLOCK_SIZE(level) - 1U))
@@ -667,6 +695,108 @@ static uintptr_t xlat_tables_map_region(xlat_ctx_t *ctx, mmap_region_t *mm,
 	return table_idx_va - 1U;
 }
 
+/*
+ * Returns true if the given VA range is entirely mapped by a single static
+ * region of the context.
+ */
+static bool xlat_range_is_static(const xlat_ctx_t *ctx, uintptr_t base_va,
+				 unsigned long long size)
+{
+#if PLAT_XLAT_TABLES_DYNAMIC
+	uintptr_t end_va = base_va + (uintptr_t)size - 1U;
+
+	for (const mmap_region_t *mm = ctx->mmap; mm->size != 0U; mm++) {
+		if ((mm->attr & MT_DYNAMIC) != 0U)
+			continue;
+
+		if ((base_va >= mm->base_va) &&
+		    (end_va <= (mm->base_va + mm->size - 1U)))
+			return true;
+	}
+
+	return false;
+#else
+	/* All the regions are static */
+	return true;
+#endif
+}
+
+/*
+ * Recursive function that sets the Contiguous hint in all the groups of
+ * XLAT_CONT_HINT_ENTRIES block or page descriptors that can use it, i.e. that
+ * are aligned in the table, map a contiguous and equally aligned physical
+ * range, and have identical attributes. This lets the TLB cache each group in
+ * a single entry. It must only be used on translation tables that are not in
+ * use, as it doesn't follow the break-before-make sequence.
+ *
+ * Only groups within a static region get the hint. Dynamic regions can be
+ * unmapped at runtime, which would leave a partially unmapped group with the
+ * Contiguous hint set.
+ */
+static void xlat_tables_set_cont_hint(const xlat_ctx_t *ctx,
+				      uint64_t *const table_base,
+				      unsigned int table_entries,
+				      uintptr_t table_base_va,
+				      unsigned int level)
+{
+	unsigned long long block_size = XLAT_BLOCK_SIZE(level);
+	unsigned long long group_size = block_size * XLAT_CONT_HINT_ENTRIES;
+	uint64_t leaf_type = (level == XLAT_TABLE_LEVEL_MAX) ?
+			     PAGE_DESC : BLOCK_DESC;
+	unsigned int idx, j;
+
+	if (level < XLAT_TABLE_LEVEL_MAX) {
+		for (idx = 0U; idx < table_entries; idx++) {
+			uint64_t desc = table_base[idx];
+			uint64_t *subtable;
+
+			if ((desc & DESC_MASK) != TABLE_DESC)
+				continue;
+
+			subtable = (uint64_t *)(uintptr_t)(desc & TABLE_ADDR_MASK);
+			xlat_tables_set_cont_hint(ctx, subtable,
+				XLAT_TABLE_ENTRIES,
+				table_base_va + (uintptr_t)(idx * block_size),
+				level + 1U);
+#if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
+			xlat_clean_dcache_range((uintptr_t)subtable,
+				XLAT_TABLE_ENTRIES * sizeof(uint64_t));
+#endif
+		}
+	}
+
+	/* There are no block descriptors below the minimum block level */
+	if (level < MIN_LVL_BLOCK_DESC)
+		return;
+
+	for (idx = 0U; (idx + XLAT_CONT_HINT_ENTRIES) <= table_entries;
+	     idx += XLAT_CONT_HINT_ENTRIES) {
+		uint64_t first = table_base[idx];
+
+		if ((first & DESC_MASK) != leaf_type)
+			continue;
+
+		if (((first & TABLE_ADDR_MASK) & (group_size - 1U)) != 0U)
+			continue;
+
+		for (j = 1U; j < XLAT_CONT_HINT_ENTRIES; j++) {
+			if (table_base[idx + j] != (first + (j * block_size)))
+				break;
+		}
+
+		if (j != XLAT_CONT_HINT_ENTRIES)
+			continue;
+
+		if (!xlat_range_is_static(ctx,
+				table_base_va + (uintptr_t)(idx * block_size),
+				group_size))
+			continue;
+
+		for (j = 0U; j < XLAT_CONT_HINT_ENTRIES; j++)
+			table_base[idx + j] |= UPPER_ATTRS(CONT_HINT);
+	}
+}
+
 /*
  * Function that verifies that a region can be mapped.
  * Returns:
@@ -1203,27 +1333,23 @@ void __init init_xlat_tables_ctx(xlat_ctx_t *ctx)
 
 	xlat_mmap_print(mm);
 
-	/* All tables must be zeroed before mapping any region. */
+	/*
+	 * The base table must be zeroed before mapping any region. The other
+	 * tables are zeroed when they are allocated.
+	 */
 
 	for (unsigned int i = 0U; i < ctx->base_table_entries; i++)
 		ctx->base_table[i] = INVALID_DESC;
 
-	for (int j = 0; j < ctx->tables_num; j++) {
 #if PLAT_XLAT_TABLES_DYNAMIC
+	for (int j = 0; j < ctx->tables_num; j++)
 		ctx->tables_mapped_regions[j] = 0;
 #endif
-		for (unsigned int i = 0U; i < XLAT_TABLE_ENTRIES; i++)
-			ctx->tables[j][i] = INVALID_DESC;
-	}
 
 	while (mm->size != 0U) {
 		uintptr_t end_va = xlat_tables_map_region(ctx, mm, 0U,
 				ctx->base_table, ctx->base_table_entries,
 				ctx->base_level);
-#if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
-		xlat_clean_dcache_range((uintptr_t)ctx->base_table,
-				   ctx->base_table_entries * sizeof(uint64_t));
-#endif
 		if (end_va != (mm->base_va + mm->size - 1U)) {
 			ERROR("Not enough memory to map region:\n"
 			      " VA:0x%lx  PA:0x%llx  size:0x%zx  attr:0x%x\n",
@@ -1234,6 +1360,96 @@ void __init init_xlat_tables_ctx(xlat_ctx_t *ctx)
 		mm++;
 	}
 
+	/*
+	 * Only static regions get the Contiguous hint, including when dynamic
+	 * regions were added before this point. Dynamic regions mapped later
+	 * can't overlap static ones, so they never break up a group.
+	 *
+	 * This also cleans each table once from the data cache, if enabled.
+	 */
+	xlat_tables_set_cont_hint(ctx, ctx->base_table,
+				  ctx->base_table_entries, 0U,
+				  ctx->base_level);
+#if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
+	xlat_clean_dcache_range((uintptr_t)ctx->base_table,
+			   ctx->base_table_entries * sizeof(uint64_t));
+#endif
+
+	assert(ctx->pa_max_address <= xlat_arch_get_max_supported_pa());
+	assert(ctx->max_va <= ctx->va_max_address);
+	assert(ctx->max_pa <= ctx->pa_max_address);
+
+	ctx->initialized = true;
+
+	xlat_tables_print(ctx);
+}
+
+#if XLAT_TABLES_PREBUILT
+
+bool __init install_prebuilt_xlat_tables_ctx(xlat_ctx_t *ctx,
+					     const xlat_prebuilt_info_t *info)
+{
+	assert(ctx != NULL);
+	assert(info != NULL);
+	assert(!ctx->initialized);
+	assert(!is_mmu_enabled_ctx(ctx));
+	assert(ctx->tables_num <= MAX_XLAT_TABLES);
+	assert(ctx->mmap_num <= MAX_MMAP_REGIONS);
+
+	if (info->magic != XLAT_PREBUILT_MAGIC) {
+		WARN("Translation tables were not generated at build time\n");
+		return false;
+	}
+
+	if (info->xlat_regime != (uint64_t)ctx->xlat_regime) {
+		WARN("Translation tables generated for another regime\n");
+		return false;
+	}
+
+	/* The GP bit is set in the code regions if BTI is enabled */
+	if (((info->flags & XLAT_PREBUILT_FLAG_BTI) != 0U) &&
+	    !is_armv8_5_bti_present()) {
+		VERBOSE("BTI not present, building the translation tables\n");
+		return false;
+	}
+
+	/*
+	 * The regions must be exactly the ones the tables were generated for,
+	 * in the order in which mmap_add_region_ctx() sorted them.
+	 */
+	for (int i = 0; i <= ctx->mmap_num; i++) {
+		const mmap_region_t *mm = &ctx->mmap[i];
+		const mmap_region_t *prebuilt = &info->mmap[i];
+
+		if ((mm->base_pa != prebuilt->base_pa) ||
+		    (mm->base_va != prebuilt->base_va) ||
+		    (mm->size != prebuilt->size) ||
+		    (mm->attr != prebuilt->attr) ||
+		    (mm->granularity != prebuilt->granularity)) {
+			WARN("Memory map differs from the one of the "
+			     "translation tables generated at build time\n");
+			return false;
+		}
+
+		if (mm->size == 0U)
+			break;
+	}
+
+	xlat_mmap_print(ctx->mmap);
+
+	ctx->next_table = (int)info->next_table;
+#if PLAT_XLAT_TABLES_DYNAMIC
+	for (int j = 0; j < ctx->tables_num; j++)
+		ctx->tables_mapped_regions[j] = (int)info->mapped_regions[j];
+#endif
+
+#if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
+	xlat_clean_dcache_range((uintptr_t)ctx->tables,
+		(size_t)ctx->tables_num * XLAT_TABLE_SIZE);
+	xlat_clean_dcache_range((uintptr_t)ctx->base_table,
+		ctx->base_table_entries * sizeof(uint64_t));
+#endif
+
 	assert(ctx->pa_max_address <= xlat_arch_get_max_supported_pa());
 	assert(ctx->max_va <= ctx->va_max_address);
 	assert(ctx->max_pa <= ctx->pa_max_address);
@@ -1241,4 +1457,8 @@ void __init init_xlat_tables_ctx(xlat_ctx_t *ctx)
 	ctx->initialized = true;
 
 	xlat_tables_print(ctx);
+
+	return true;
 }
+
+#endif /* XLAT_TABLES_PREBUILT */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2021, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2023, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -38,6 +38,13 @@
 
 #endif /* PLAT_XLAT_TABLES_DYNAMIC */
 
+/*
+ * Number of consecutive block or page descriptors that are grouped with the
+ * Contiguous hint, for the 4KB translation granule. The group must be aligned
+ * to this number of entries in the table and in the output address space.
+ */
+#define XLAT_CONT_HINT_ENTRIES	U(16)
+
 extern uint64_t mmu_cfg_params[MMU_CFG_PARAM_MAX];
 
 /* Determine the physical address space encoded in the 'attr' parameter. */
@@ -62,9 +69,16 @@ uint64_t xlat_arch_regime_get_xn_desc(int xlat_regime);
  */
 void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime);
 
+/*
+ * Invalidate all TLB entries that match the given virtual address range, in the
+ * same way as xlat_arch_tlbi_va() does for a single page. The range must be
+ * page aligned. TLBI range operations are used when FEAT_TLBIRANGE is present.
+ */
+void xlat_arch_tlbi_va_range(uintptr_t va, size_t size, int xlat_regime);
+
 /*
  * This function has to be called at the end of any code that uses the function
- * xlat_arch_tlbi_va().
+ * xlat_arch_tlbi_va() or xlat_arch_tlbi_va_range().
  */
 void xlat_arch_tlbi_va_sync(void);
 
@@ -107,4 +121,53 @@ bool is_mmu_enabled_ctx(const xlat_ctx_t *ctx);
  */
 uintptr_t xlat_get_min_virt_addr_space_size(void);
 
+#if XLAT_TABLES_PREBUILT
+
+#define XLAT_PREBUILT_MAGIC		ULL(0x584C4154)	/* "XLAT" */
+#define XLAT_PREBUILT_VERSION		ULL(1)
+
+#define XLAT_PREBUILT_FLAG_BTI		(ULL(1) << 0)
+#define XLAT_PREBUILT_FLAG_RME		(ULL(1) << 1)
+#define XLAT_PREBUILT_FLAG_DYNAMIC	(ULL(1) << 2)
+
+/*
+ * Translation tables of a context generated when the image is linked, by
+ * tools/xlat_prebuilt/xlat_prebuilt.py. The fields up to `manifest` are set by
+ * the compiler and describe the context to the tool, which fills in the other
+ * ones along with the tables themselves, and sets `magic` last. All the fields
+ * are 64-bit wide so that the layout doesn't depend on the compiler. It must be
+ * kept in sync with the tool.
+ */
+typedef struct xlat_prebuilt_info {
+	uint64_t magic;
+	uint64_t version;
+	uint64_t xlat_regime;
+	uint64_t flags;
+	uint64_t pa_max_address;
+	uint64_t va_max_address;
+	uint64_t base_level;
+	uint64_t base_table;
+	uint64_t base_table_entries;
+	uint64_t tables;
+	uint64_t tables_num;
+	uint64_t mmap_num;
+	uint64_t manifest;
+
+	/* Filled in by the tool */
+	uint64_t next_table;
+	uint64_t mapped_regions[MAX_XLAT_TABLES];
+	mmap_region_t mmap[MAX_MMAP_REGIONS + 1];
+} xlat_prebuilt_info_t;
+
+/*
+ * Use the translation tables generated at build time for the context, instead
+ * of building them, if they were generated for the regions added to it and for
+ * its translation regime. Returns false if they can't be used, in which case
+ * init_xlat_tables_ctx() must be called.
+ */
+bool install_prebuilt_xlat_tables_ctx(xlat_ctx_t *ctx,
+				      const xlat_prebuilt_info_t *info);
+
+#endif /* XLAT_TABLES_PREBUILT */
+
 #endif /* XLAT_TABLES_PRIVATE_H */
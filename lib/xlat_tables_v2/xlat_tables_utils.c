@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2021, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2023, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -114,6 +114,10 @@ static void xlat_desc_print(const xlat_ctx_t *ctx, uint64_t desc)
 	printf(((LOWER_ATTRS(NS) & desc) != 0ULL) ? "-NS" : "-S");
 #endif
 
+	if ((desc & UPPER_ATTRS(CONT_HINT)) != 0ULL) {
+		printf("-CONT");
+	}
+
 #ifdef __aarch64__
 	/* Check Guarded Page bit */
 	if ((desc & GP) != 0ULL) {
@@ -219,8 +223,38 @@ static void xlat_tables_print_internal(xlat_ctx_t *ctx, uintptr_t table_base_va,
 	}
 }
 
+/*
+ * Recursive function that counts the block and page descriptors of the
+ * translation tables, and how many of them have the Contiguous hint set.
+ */
+static void xlat_tables_count_descs(const uint64_t *table_base,
+		unsigned int table_entries, unsigned int level,
+		unsigned int *leaf_count, unsigned int *cont_count)
+{
+	for (unsigned int i = 0U; i < table_entries; i++) {
+		uint64_t desc = table_base[i];
+
+		if ((desc & DESC_MASK) == INVALID_DESC)
+			continue;
+
+		if (((desc & DESC_MASK) == TABLE_DESC) &&
+				(level < XLAT_TABLE_LEVEL_MAX)) {
+			xlat_tables_count_descs(
+				(uint64_t *)(uintptr_t)(desc & TABLE_ADDR_MASK),
+				XLAT_TABLE_ENTRIES, level + 1U,
+				leaf_count, cont_count);
+			continue;
+		}
+
+		(*leaf_count)++;
+		if ((desc & UPPER_ATTRS(CONT_HINT)) != 0ULL)
+			(*cont_count)++;
+	}
+}
+
 void xlat_tables_print(xlat_ctx_t *ctx)
 {
+	unsigned int leaf_count = 0U, cont_count = 0U;
 	const char *xlat_regime_str;
 	int used_page_tables;
 
@@ -256,6 +290,17 @@ void xlat_tables_print(xlat_ctx_t *ctx)
 		used_page_tables, ctx->tables_num,
 		ctx->tables_num - used_page_tables);
 
+	/*
+	 * Each group of descriptors with the Contiguous hint can be held in a
+	 * single TLB entry.
+	 */
+	xlat_tables_count_descs(ctx->base_table, ctx->base_table_entries,
+				ctx->base_level, &leaf_count, &cont_count);
+	VERBOSE("  Block/page descriptors: %u, %u with contiguous hint\n",
+		leaf_count, cont_count);
+	VERBOSE("  TLB entries saved by contiguous hint: %u\n",
+		cont_count - (cont_count / XLAT_CONT_HINT_ENTRIES));
+
 	xlat_tables_print_internal(ctx, 0U, ctx->base_table,
 				   ctx->base_table_entries, ctx->base_level);
 }
@@ -342,6 +387,52 @@ static uint64_t *find_xlat_table_entry(uintptr_t virtual_addr,
 }
 
 
+/*
+ * Convert the attributes of a block or page descriptor to MT_* attributes.
+ */
+static uint32_t xlat_desc_get_attributes(const xlat_ctx_t *ctx, uint64_t desc)
+{
+	uint32_t attributes = 0U;
+
+	uint64_t attr_index = (desc >> ATTR_INDEX_SHIFT) & ATTR_INDEX_MASK;
+
+	if (attr_index == ATTR_IWBWA_OWBWA_NTR_INDEX) {
+		attributes |= MT_MEMORY;
+	} else if (attr_index == ATTR_NON_CACHEABLE_INDEX) {
+		attributes |= MT_NON_CACHEABLE;
+	} else {
+		assert(attr_index == ATTR_DEVICE_INDEX);
+		attributes |= MT_DEVICE;
+	}
+
+	uint64_t ap2_bit = (desc >> AP2_SHIFT) & 1U;
+
+	if (ap2_bit == AP2_RW)
+		attributes |= MT_RW;
+
+	if (ctx->xlat_regime == EL1_EL0_REGIME) {
+		uint64_t ap1_bit = (desc >> AP1_SHIFT) & 1U;
+
+		if (ap1_bit == AP1_ACCESS_UNPRIVILEGED)
+			attributes |= MT_USER;
+	}
+
+	uint64_t ns_bit = (desc >> NS_SHIFT) & 1U;
+
+	if (ns_bit == 1U)
+		attributes |= MT_NS;
+
+	uint64_t xn_mask = xlat_arch_regime_get_xn_desc(ctx->xlat_regime);
+
+	if ((desc & xn_mask) == xn_mask) {
+		attributes |= MT_EXECUTE_NEVER;
+	} else {
+		assert((desc & xn_mask) == 0U);
+	}
+
+	return attributes;
+}
+
 static int xlat_get_mem_attributes_internal(const xlat_ctx_t *ctx,
 		uintptr_t base_va, uint32_t *attributes, uint64_t **table_entry,
 		unsigned long long *addr_pa, unsigned int *table_level)
@@ -394,43 +485,7 @@ static int xlat_get_mem_attributes_internal(const xlat_ctx_t *ctx,
 #endif /* LOG_LEVEL >= LOG_LEVEL_VERBOSE */
 
 	assert(attributes != NULL);
-	*attributes = 0U;
-
-	uint64_t attr_index = (desc >> ATTR_INDEX_SHIFT) & ATTR_INDEX_MASK;
-
-	if (attr_index == ATTR_IWBWA_OWBWA_NTR_INDEX) {
-		*attributes |= MT_MEMORY;
-	} else if (attr_index == ATTR_NON_CACHEABLE_INDEX) {
-		*attributes |= MT_NON_CACHEABLE;
-	} else {
-		assert(attr_index == ATTR_DEVICE_INDEX);
-		*attributes |= MT_DEVICE;
-	}
-
-	uint64_t ap2_bit = (desc >> AP2_SHIFT) & 1U;
-
-	if (ap2_bit == AP2_RW)
-		*attributes |= MT_RW;
-
-	if (ctx->xlat_regime == EL1_EL0_REGIME) {
-		uint64_t ap1_bit = (desc >> AP1_SHIFT) & 1U;
-
-		if (ap1_bit == AP1_ACCESS_UNPRIVILEGED)
-			*attributes |= MT_USER;
-	}
-
-	uint64_t ns_bit = (desc >> NS_SHIFT) & 1U;
-
-	if (ns_bit == 1U)
-		*attributes |= MT_NS;
-
-	uint64_t xn_mask = xlat_arch_regime_get_xn_desc(ctx->xlat_regime);
-
-	if ((desc & xn_mask) == xn_mask) {
-		*attributes |= MT_EXECUTE_NEVER;
-	} else {
-		assert((desc & xn_mask) == 0U);
-	}
+	*attributes = xlat_desc_get_attributes(ctx, desc);
 
 	return 0;
 }
@@ -444,15 +499,52 @@ int xlat_get_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
 }
 
 
+/*
+ * Find the page descriptor that maps virtual_addr. On success, return its
+ * address and store in '*entries' the number of descriptors from it to the end
+ * of its translation table, capped to max_entries. Return NULL if virtual_addr
+ * isn't mapped at page granularity.
+ */
+static uint64_t *find_xlat_page_entries(const xlat_ctx_t *ctx,
+					uintptr_t virtual_addr,
+					size_t max_entries, size_t *entries)
+{
+	uint64_t *entry;
+	unsigned int level;
+
+	entry = find_xlat_table_entry(virtual_addr,
+				      ctx->base_table,
+				      ctx->base_table_entries,
+				      (unsigned long long)ctx->va_max_address + 1ULL,
+				      &level);
+	if (entry == NULL) {
+		WARN("Address 0x%lx is not mapped.\n", virtual_addr);
+		return NULL;
+	}
+
+	if (((*entry & DESC_MASK) != PAGE_DESC) ||
+		(level != XLAT_TABLE_LEVEL_MAX)) {
+		WARN("Address 0x%lx is not mapped at the right granularity.\n",
+		     virtual_addr);
+		WARN("Granularity is 0x%lx, should be 0x%lx.\n",
+		     XLAT_BLOCK_SIZE(level), PAGE_SIZE);
+		return NULL;
+	}
+
+	*entries = MIN(XLAT_TABLE_ENTRIES -
+		       (size_t)XLAT_TABLE_IDX(virtual_addr, level),
+		       max_entries);
+
+	return entry;
+}
+
 int xlat_change_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
 				   size_t size, uint32_t attr)
 {
-	/* Note: This implementation isn't optimized. */
-
 	assert(ctx != NULL);
 	assert(ctx->initialized);
 
-	unsigned long long virt_addr_space_size =
+	unsigned long long virt_addr_space_size __unused =
 		(unsigned long long)ctx->va_max_address + 1U;
 	assert(virt_addr_space_size > 0U);
 
@@ -480,109 +572,150 @@ int xlat_change_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
 	}
 
 	size_t pages_count = size / PAGE_SIZE;
+	size_t pages_left, entries, i;
+	uintptr_t va;
+	uint64_t *entry;
 
 	VERBOSE("Changing memory attributes of %zu pages starting from address 0x%lx...\n",
 		pages_count, base_va);
 
-	uintptr_t base_va_original = base_va;
-
 	/*
-	 * Sanity checks.
+	 * Sanity checks. The translation tables are only walked for the first
+	 * page mapped by each last level table, the descriptors of the
+	 * following pages are next to it in the same table.
 	 */
-	for (unsigned int i = 0U; i < pages_count; ++i) {
-		const uint64_t *entry;
-		uint64_t desc, attr_index;
-		unsigned int level;
-
-		entry = find_xlat_table_entry(base_va,
-					      ctx->base_table,
-					      ctx->base_table_entries,
-					      virt_addr_space_size,
-					      &level);
+	va = base_va;
+	pages_left = pages_count;
+	while (pages_left > 0U) {
+		entry = find_xlat_page_entries(ctx, va, pages_left, &entries);
 		if (entry == NULL) {
-			WARN("Address 0x%lx is not mapped.\n", base_va);
 			return -EINVAL;
 		}
 
-		desc = *entry;
+		for (i = 0U; i < entries; i++, va += PAGE_SIZE) {
+			uint64_t desc = entry[i];
 
-		/*
-		 * Check that all the required pages are mapped at page
-		 * granularity.
-		 */
-		if (((desc & DESC_MASK) != PAGE_DESC) ||
-			(level != XLAT_TABLE_LEVEL_MAX)) {
-			WARN("Address 0x%lx is not mapped at the right granularity.\n",
-			     base_va);
-			WARN("Granularity is 0x%lx, should be 0x%lx.\n",
-			     XLAT_BLOCK_SIZE(level), PAGE_SIZE);
-			return -EINVAL;
-		}
+			/*
+			 * Check that all the required pages are mapped at page
+			 * granularity.
+			 */
+			if ((desc & DESC_MASK) != PAGE_DESC) {
+				WARN("Address 0x%lx is not mapped.\n", va);
+				return -EINVAL;
+			}
 
-		/*
-		 * If the region type is device, it shouldn't be executable.
-		 */
-		attr_index = (desc >> ATTR_INDEX_SHIFT) & ATTR_INDEX_MASK;
-		if (attr_index == ATTR_DEVICE_INDEX) {
-			if ((attr & MT_EXECUTE_NEVER) == 0U) {
+			/*
+			 * If the region type is device, it shouldn't be
+			 * executable.
+			 */
+			uint64_t attr_index =
+				(desc >> ATTR_INDEX_SHIFT) & ATTR_INDEX_MASK;
+			if ((attr_index == ATTR_DEVICE_INDEX) &&
+			    ((attr & MT_EXECUTE_NEVER) == 0U)) {
 				WARN("Setting device memory as executable at address 0x%lx.",
-				     base_va);
+				     va);
 				return -EINVAL;
 			}
 		}
 
-		base_va += PAGE_SIZE;
+		pages_left -= entries;
 	}
 
-	/* Restore original value. */
-	base_va = base_va_original;
-
-	for (unsigned int i = 0U; i < pages_count; ++i) {
-
-		uint32_t old_attr = 0U, new_attr;
-		uint64_t *entry = NULL;
-		unsigned int level = 0U;
-		unsigned long long addr_pa = 0ULL;
-
-		(void) xlat_get_mem_attributes_internal(ctx, base_va, &old_attr,
-					    &entry, &addr_pa, &level);
-
-		/*
-		 * From attr, only MT_RO/MT_RW, MT_EXECUTE/MT_EXECUTE_NEVER and
-		 * MT_USER/MT_PRIVILEGED are taken into account. Any other
-		 * information is ignored.
-		 */
+	/*
+	 * Update the descriptors, one last level table at a time. The
+	 * break-before-make sequence is applied to all the descriptors of the
+	 * table that are in the range at once, so that they can be invalidated
+	 * from the TLBs with a single range operation.
+	 */
+	va = base_va;
+	pages_left = pages_count;
+	while (pages_left > 0U) {
+		uint64_t *first, *last;
+		uintptr_t first_va;
+		size_t idx;
 
-		/* Clean the old attributes so that they can be rebuilt. */
-		new_attr = old_attr & ~(MT_RW | MT_EXECUTE_NEVER | MT_USER);
+		entry = find_xlat_page_entries(ctx, va, pages_left, &entries);
+		assert(entry != NULL);
 
 		/*
-		 * Update attributes, but filter out the ones this function
-		 * isn't allowed to change.
+		 * Descriptors in a group with the Contiguous hint must be
+		 * changed together. The hint is removed from the groups at
+		 * both ends of the range, including from the descriptors of
+		 * these groups that are outside of the range and keep their
+		 * attributes.
 		 */
-		new_attr |= attr & (MT_RW | MT_EXECUTE_NEVER | MT_USER);
+		first = entry;
+		first_va = va;
+		last = entry + entries;
+		idx = (size_t)XLAT_TABLE_IDX(va, XLAT_TABLE_LEVEL_MAX);
+		if ((entry[0] & UPPER_ATTRS(CONT_HINT)) != 0U) {
+			first -= idx % XLAT_CONT_HINT_ENTRIES;
+			first_va -= (idx % XLAT_CONT_HINT_ENTRIES) * PAGE_SIZE;
+		}
+		if ((entry[entries - 1U] & UPPER_ATTRS(CONT_HINT)) != 0U) {
+			last += round_up(idx + entries, XLAT_CONT_HINT_ENTRIES) -
+				(idx + entries);
+		}
 
 		/*
-		 * The break-before-make sequence requires writing an invalid
-		 * descriptor and making sure that the system sees the change
-		 * before writing the new descriptor.
+		 * Write invalid descriptors and make sure that the system
+		 * sees the change. Only the descriptor type is cleared, the
+		 * rest of the old descriptor is used to build the new one.
 		 */
-		*entry = INVALID_DESC;
+		for (uint64_t *p = first; p < last; p++) {
+			*p &= ~(uint64_t)DESC_MASK;
+		}
 #if !HW_ASSISTED_COHERENCY
-		dccvac((uintptr_t)entry);
+		clean_dcache_range((uintptr_t)first,
+				   (size_t)(last - first) * sizeof(uint64_t));
 #endif
-		/* Invalidate any cached copy of this mapping in the TLBs. */
-		xlat_arch_tlbi_va(base_va, ctx->xlat_regime);
+		/* Invalidate any cached copy of these mappings in the TLBs. */
+		xlat_arch_tlbi_va_range(first_va,
+					(size_t)(last - first) * PAGE_SIZE,
+					ctx->xlat_regime);
 
 		/* Ensure completion of the invalidation. */
 		xlat_arch_tlbi_va_sync();
 
-		/* Write new descriptor */
-		*entry = xlat_desc(ctx, new_attr, addr_pa, level);
+		/* Restore the descriptors of the groups outside of the range */
+		for (uint64_t *p = first; p < entry; p++) {
+			*p = (*p & ~UPPER_ATTRS(CONT_HINT)) | PAGE_DESC;
+		}
+		for (uint64_t *p = entry + entries; p < last; p++) {
+			*p = (*p & ~UPPER_ATTRS(CONT_HINT)) | PAGE_DESC;
+		}
+
+		for (i = 0U; i < entries; i++) {
+			uint64_t old_desc = entry[i];
+			uint32_t new_attr;
+
+			/*
+			 * From attr, only MT_RO/MT_RW, MT_EXECUTE/
+			 * MT_EXECUTE_NEVER and MT_USER/MT_PRIVILEGED are taken
+			 * into account. Any other information is ignored.
+			 */
+
+			/* Clean the old attributes so that they can be rebuilt. */
+			new_attr = xlat_desc_get_attributes(ctx, old_desc) &
+				   ~(MT_RW | MT_EXECUTE_NEVER | MT_USER);
+
+			/*
+			 * Update attributes, but filter out the ones this
+			 * function isn't allowed to change.
+			 */
+			new_attr |= attr & (MT_RW | MT_EXECUTE_NEVER | MT_USER);
+
+			/* Write new descriptor */
+			entry[i] = xlat_desc(ctx, new_attr,
+					     old_desc & TABLE_ADDR_MASK,
+					     XLAT_TABLE_LEVEL_MAX);
+		}
 #if !HW_ASSISTED_COHERENCY
-		dccvac((uintptr_t)entry);
+		clean_dcache_range((uintptr_t)first,
+				   (size_t)(last - first) * sizeof(uint64_t));
 #endif
-		base_va += PAGE_SIZE;
+		va += entries * PAGE_SIZE;
+		pages_left -= entries;
 	}
 
 	/* Ensure that the last descriptor written is seen by the system. */
@@ -583,6 +583,10 @@ else
 		$(BUILD_DIR)/build_message.o \
 		$(OBJS) $(LDPATHS) $(LIBWRAPPER) $(LDLIBS) $(BL_LIBS)
 endif
+ifneq ($(and $(filter 1,$(XLAT_TABLES_PREBUILT)),$(filter bl2 bl31,$(1))),)
+	$$(ECHO) "  XLAT    $$@"
+	$$(Q)$$(PYTHON) $(XLAT_PREBUILT) $$@
+endif
 ifeq ($(DISABLE_BIN_GENERATION),1)
 	@${ECHO_BLANK_LINE}
 	@echo "Built $$@ successfully"
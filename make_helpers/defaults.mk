@@ -79,6 +79,9 @@ DISABLE_BIN_GENERATION		:= 0
 # development platforms.
 DYN_DISABLE_AUTH		:= 0
 
+# Flag to enable fine-grained boot phase timestamps using PMF
+ENABLE_BOOT_PHASE_MARKERS	:= 0
+
 # Enable the Maximum Power Mitigation Mechanism on supporting cores.
 ENABLE_MPMM			:= 0
 
@@ -88,9 +91,21 @@ ENABLE_MPMM_FCONF		:= 0
 # Flag to Enable Position Independant support (PIE)
 ENABLE_PIE			:= 0
 
+# Flag to record the INFO and VERBOSE messages of BL31 in a binary log
+ENABLE_BINARY_LOG		:= 0
+
+# Flag to add a SiP call changing the log level of BL31 at runtime
+ENABLE_LOG_LEVEL_SMC		:= 0
+
+# Flag to rate limit the ERROR and WARN messages of BL31
+ENABLE_LOG_RATELIMIT		:= 0
+
 # Flag to enable Performance Measurement Framework
 ENABLE_PMF			:= 0
 
+# Flag to record PMF events into per-CPU trace rings
+ENABLE_PMF_TRACE		:= 0
+
 # Flag to enable PSCI STATs functionality
 ENABLE_PSCI_STAT		:= 0
 
@@ -103,6 +118,9 @@ ENABLE_STACK_PROTECTOR		:= 0
 # Flag to enable exception handling in EL3
 EL3_EXCEPTION_HANDLING		:= 0
 
+# Flag to enable the statistics of the EL3 exception handling priority levels
+EHF_STATS			:= 0
+
 # By default BL31 encryption disabled
 ENCRYPT_BL31			:= 0
 
@@ -178,6 +196,9 @@ NS_TIMER_SWITCH			:= 0
 # Include lib/libc in the final image
 OVERRIDE_LIBC			:= 0
 
+# Let the platform place the per-CPU data of each chip in its local memory
+PER_CHIP_CPU_DATA		:= 0
+
 # Build PL011 UART driver in minimal generic UART mode
 PL011_GENERIC_UART		:= 0
 
@@ -185,9 +206,21 @@ PL011_GENERIC_UART		:= 0
 # The platform Makefile is free to override this value.
 PROGRAMMABLE_RESET_ADDRESS	:= 0
 
+# Keep CPUs in an EL3 holding pen on CPU_OFF instead of powering them down
+PSCI_CPU_OFF_TO_PEN		:= 0
+
+# Power up the secondary CPUs during cold boot and park them in EL3
+PSCI_EARLY_CPU_INIT		:= 0
+
+# Demote power domain states whose predicted residency is too short
+PSCI_IDLE_GOVERNOR		:= 0
+
 # Flag used to choose the power state format: Extended State-ID or Original
 PSCI_EXTENDED_STATE_ID		:= 0
 
+# Allow the PSCI statistics of all power domains to be read in one SiP call
+PSCI_STAT_SNAPSHOT		:= 0
+
 # Enable PSCI OS-initiated mode support
 PSCI_OS_INIT_MODE		:= 0
 
@@ -275,6 +308,10 @@ USE_ROMLIB			:= 0
 # level makefile where we can check for incompatible features/build options.
 ALLOW_RO_XLAT_TABLES		:= 0
 
+# Build option to generate the translation tables of BL31 and BL2 when the
+# images are linked, instead of building them at runtime.
+XLAT_TABLES_PREBUILT		:= 0
+
 # Chain of trust.
 COT				:= tbbr
 
@@ -320,6 +357,13 @@ ERRATA_SPECULATIVE_AT		:= 0
 # Trap RAS error record access from Non secure
 RAS_TRAP_NS_ERR_REC_ACCESS	:= 0
 
+# Report RAS errors to the Normal world in batches, polling the error records
+# during corrected error storms
+RAS_CE_BATCHING			:= 0
+
+# Set by platforms implementing plat_ras_poll_timer_arm()
+PLAT_RAS_POLL_TIMER		:= 0
+
 # Build option to create cot descriptors using fconf
 COT_DESC_IN_DTB			:= 0
 
@@ -368,6 +412,9 @@ PSA_CRYPTO			:= 0
 # should only be enabled if there is a use case for it.
 ENABLE_CONSOLE_GETC		:= 0
 
+# Flag to buffer the console output of BL2 and BL31 in per-CPU rings
+ENABLE_CONSOLE_RING		:= 0
+
 # Build option to disable EL2 when it is not used.
 # Most platforms switch from EL3 to NS-EL2 and hence the unused NS-EL2
 # functions must be enabled by platforms if they require it.
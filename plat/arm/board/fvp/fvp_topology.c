@@ -121,3 +121,35 @@ int plat_core_pos_by_mpidr(u_register_t mpidr)
 	mpidr |= (read_mpidr_el1() & MPIDR_MT_MASK);
 	return (int) plat_arm_calc_core_pos(mpidr);
 }
+
+#if PSCI_EARLY_CPU_INIT
+/*******************************************************************************
+ * This function is the inverse of plat_core_pos_by_mpidr(). It returns the
+ * MPIDR of the cpu at linear index `core_pos`, or INVALID_MPID if that cpu
+ * is not present on this model.
+ ******************************************************************************/
+u_register_t plat_core_pos_to_mpidr(unsigned int core_pos)
+{
+	unsigned int clus_id, cpu_id, thread_id;
+	u_register_t mpidr;
+
+	thread_id = core_pos % FVP_MAX_PE_PER_CPU;
+	cpu_id = (core_pos / FVP_MAX_PE_PER_CPU) % FVP_MAX_CPUS_PER_CLUSTER;
+	clus_id = core_pos / (FVP_MAX_PE_PER_CPU * FVP_MAX_CPUS_PER_CLUSTER);
+
+	if ((arm_config.flags & ARM_CONFIG_FVP_SHIFTED_AFF) != 0U) {
+		mpidr = ((u_register_t)thread_id << MPIDR_AFF0_SHIFT) |
+			((u_register_t)cpu_id << MPIDR_AFF1_SHIFT) |
+			((u_register_t)clus_id << MPIDR_AFF2_SHIFT);
+	} else {
+		mpidr = ((u_register_t)cpu_id << MPIDR_AFF0_SHIFT) |
+			((u_register_t)clus_id << MPIDR_AFF1_SHIFT);
+	}
+
+	if (plat_core_pos_by_mpidr(mpidr) != (int)core_pos) {
+		return INVALID_MPID;
+	}
+
+	return mpidr | (read_mpidr_el1() & MPIDR_MT_MASK);
+}
+#endif /* PSCI_EARLY_CPU_INIT */
@@ -176,6 +176,38 @@ static void arm_bl2_plat_gpt_setup(void)
 }
 #endif /* ENABLE_RME */
 
+#if XLAT_TABLES_PREBUILT
+/*
+ * Regions of bl_regions in arm_bl2_plat_arch_setup(), for the translation
+ * tables generated at build time. Keep both lists in sync. The Trusted SRAM
+ * layout is the one that BL1 passes to BL2.
+ */
+static const xlat_prebuilt_region_t arm_bl2_prebuilt_regions[] = {
+	XLAT_PREBUILT_REGION_FLAT(ARM_BL_RAM_BASE,
+				  ARM_BL_RAM_BASE + ARM_BL_RAM_SIZE,
+#if ENABLE_RME
+				  MT_MEMORY | MT_RW | MT_ROOT),
+#else
+				  MT_MEMORY | MT_RW | MT_SECURE),
+#endif
+	ARM_PREBUILT_BL_RO,
+#if USE_ROMLIB
+	ARM_PREBUILT_ROMLIB_CODE,
+	ARM_PREBUILT_ROMLIB_DATA,
+#endif
+	XLAT_PREBUILT_REGION_FLAT(ARM_BL_RAM_BASE, ARM_FW_CONFIGS_LIMIT,
+				  MT_MEMORY | MT_RW | EL3_PAS),
+#if ENABLE_RME
+	XLAT_PREBUILT_REGION_FLAT(ARM_L0_GPT_ADDR_BASE,
+				  ARM_L0_GPT_ADDR_BASE + ARM_L0_GPT_SIZE,
+				  MT_MEMORY | MT_RW | MT_ROOT),
+#endif
+	{0}
+};
+
+XLAT_PREBUILT_MMAP(arm_bl2_prebuilt_regions, plat_arm_mmap);
+#endif /* XLAT_TABLES_PREBUILT */
+
 /*******************************************************************************
  * Perform the very early platform specific architectural setup here.
  * When RME is enabled the secure environment is initialised before
@@ -11,6 +11,7 @@
 #include <common/bl_common.h>
 #include <common/debug.h>
 #include <drivers/console.h>
+#include <lib/bootmarker_capture.h>
 #include <lib/debugfs.h>
 #include <lib/extensions/ras.h>
 #include <lib/gpt_rme/gpt_rme.h>
@@ -287,8 +288,10 @@ void bl31_early_platform_setup2(u_register_t arg0, u_register_t arg1,
 void arm_bl31_platform_setup(void)
 {
 	/* Initialize the GIC driver, cpu and distributor interfaces */
+	BOOT_PHASE_START(BOOT_PHASE_GIC_INIT, BOOT_PHASE_NO_IMAGE);
 	plat_arm_gic_driver_init();
 	plat_arm_gic_init();
+	BOOT_PHASE_END(BOOT_PHASE_GIC_INIT, BOOT_PHASE_NO_IMAGE);
 
 #if RESET_TO_BL31
 	/*
@@ -396,6 +399,41 @@ void bl31_plat_runtime_setup(void)
 	arm_bl31_plat_runtime_setup();
 }
 
+#if XLAT_TABLES_PREBUILT
+/*
+ * Regions of bl_regions in arm_bl31_plat_arch_setup(), for the translation
+ * tables generated at build time. Keep both lists in sync.
+ */
+static const xlat_prebuilt_region_t arm_bl31_prebuilt_regions[] = {
+	XLAT_PREBUILT_REGION_FLAT(__BL31_START__, __BL31_END__,
+				  MT_MEMORY | MT_RW | EL3_PAS),
+#if ENABLE_RME
+	XLAT_PREBUILT_REGION_FLAT(ARM_L0_GPT_ADDR_BASE,
+				  ARM_L0_GPT_ADDR_BASE + ARM_L0_GPT_SIZE,
+				  MT_MEMORY | MT_RW | MT_ROOT),
+#endif
+#if RECLAIM_INIT_CODE
+	XLAT_PREBUILT_REGION_FLAT(__INIT_CODE_START__, __INIT_CODE_END__,
+				  MT_CODE | EL3_PAS),
+#endif
+#if SEPARATE_NOBITS_REGION
+	XLAT_PREBUILT_REGION_FLAT(BL31_NOBITS_BASE, BL31_NOBITS_LIMIT,
+				  MT_MEMORY | MT_RW | EL3_PAS),
+#endif
+	ARM_PREBUILT_BL_RO,
+#if USE_ROMLIB
+	ARM_PREBUILT_ROMLIB_CODE,
+	ARM_PREBUILT_ROMLIB_DATA,
+#endif
+#if USE_COHERENT_MEM
+	ARM_PREBUILT_BL_COHERENT_RAM,
+#endif
+	{0}
+};
+
+XLAT_PREBUILT_MMAP(arm_bl31_prebuilt_regions, plat_arm_mmap);
+#endif /* XLAT_TABLES_PREBUILT */
+
 /*******************************************************************************
  * Perform the very early platform specific architectural setup shared between
  * ARM standard platforms. This only does basic initialization. Later
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2022, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2018-2023, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -11,6 +11,7 @@
 #include <common/debug.h>
 #include <drivers/arm/pl011.h>
 #include <drivers/console.h>
+#include <lib/bootmarker_capture.h>
 #include <plat/arm/common/plat_arm.h>
 
 #pragma weak arm_console_runtime_init
@@ -30,10 +31,15 @@ void __init arm_console_boot_init(void)
 		return;
 	}
 
+	BOOT_PHASE_START(BOOT_PHASE_CONSOLE_INIT, BOOT_PHASE_NO_IMAGE);
+
 	int rc = console_pl011_register(PLAT_ARM_BOOT_UART_BASE,
 					PLAT_ARM_BOOT_UART_CLK_IN_HZ,
 					ARM_CONSOLE_BAUDRATE,
 					&arm_boot_console);
+
+	BOOT_PHASE_END(BOOT_PHASE_CONSOLE_INIT, BOOT_PHASE_NO_IMAGE);
+
 	if (rc == 0) {
 		/*
 		 * The crash console doesn't use the multi console API, it uses
@@ -6,11 +6,15 @@
 
 #include <stdint.h>
 
+#include <bl31/ehf_stats.h>
 #include <common/debug.h>
 #include <common/runtime_svc.h>
+#include <common/tf_log_smc.h>
+#include <drivers/arm/css/scmi_stats.h>
 #include <drivers/arm/ethosn.h>
 #include <lib/debugfs.h>
 #include <lib/pmf/pmf.h>
+#include <lib/psci/psci_stat_snapshot.h>
 #include <plat/arm/common/arm_sip_svc.h>
 #include <plat/arm/common/plat_arm.h>
 #include <tools_share/uuid.h>
@@ -81,6 +85,42 @@ static uintptr_t arm_sip_handler(unsigned int smc_fid,
 
 #endif /* USE_DEBUGFS */
 
+#if PSCI_STAT_SNAPSHOT
+
+	if (is_psci_stat_snapshot_fid(smc_fid)) {
+		return psci_stat_snapshot_smc_handler(smc_fid, x1, x2, x3, x4,
+						      cookie, handle, flags);
+	}
+
+#endif /* PSCI_STAT_SNAPSHOT */
+
+#if ENABLE_LOG_LEVEL_SMC
+
+	if (is_tf_log_fid(smc_fid)) {
+		return tf_log_smc_handler(smc_fid, x1, x2, x3, x4, cookie,
+					  handle, flags);
+	}
+
+#endif /* ENABLE_LOG_LEVEL_SMC */
+
+#if EHF_STATS
+
+	if (is_ehf_stats_fid(smc_fid)) {
+		return ehf_stats_smc_handler(smc_fid, x1, x2, x3, x4, cookie,
+					     handle, flags);
+	}
+
+#endif /* EHF_STATS */
+
+#if CSS_SCMI_STATS
+
+	if (is_scmi_stats_fid(smc_fid)) {
+		return scmi_stats_smc_handler(smc_fid, x1, x2, x3, x4, cookie,
+					      handle, flags);
+	}
+
+#endif /* CSS_SCMI_STATS */
+
 #if ETHOSN_NPU_DRIVER
 
 	if (is_ethosn_fid(smc_fid)) {
@@ -114,6 +154,26 @@ static uintptr_t arm_sip_handler(unsigned int smc_fid,
 		/* PMF calls */
 		call_count += PMF_NUM_SMC_CALLS;
 
+#if PSCI_STAT_SNAPSHOT
+		/* PSCI statistics snapshot calls */
+		call_count += PSCI_STAT_SNAPSHOT_NUM_SMC_CALLS;
+#endif /* PSCI_STAT_SNAPSHOT */
+
+#if ENABLE_LOG_LEVEL_SMC
+		/* Log level calls */
+		call_count += TF_LOG_NUM_SMC_CALLS;
+#endif /* ENABLE_LOG_LEVEL_SMC */
+
+#if EHF_STATS
+		/* EHF statistics calls */
+		call_count += EHF_STATS_NUM_SMC_CALLS;
+#endif /* EHF_STATS */
+
+#if CSS_SCMI_STATS
+		/* SCMI statistics calls */
+		call_count += SCMI_STATS_NUM_SMC_CALLS;
+#endif /* CSS_SCMI_STATS */
+
 #if ETHOSN_NPU_DRIVER
 		/* ETHOSN calls */
 		call_count += ETHOSN_NUM_SMC_CALLS;
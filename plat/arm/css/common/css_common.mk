@@ -1,5 +1,5 @@
 #
-# Copyright (c) 2015-2022, Arm Limited and Contributors. All rights reserved.
+# Copyright (c) 2015-2023, Arm Limited and Contributors. All rights reserved.
 #
 # SPDX-License-Identifier: BSD-3-Clause
 #
@@ -81,6 +81,43 @@ endif
 $(eval $(call assert_boolean,CSS_USE_SCMI_SDS_DRIVER))
 $(eval $(call add_define,CSS_USE_SCMI_SDS_DRIVER))
 
+# Process CSS_SCMI_POST_PWR_DOWN flag
+# Post the SCMI POWER_STATE_SET requests issued on the CPU_OFF and CPU_SUSPEND
+# paths instead of waiting for the SCP to respond to them.
+CSS_SCMI_POST_PWR_DOWN		?= 0
+$(eval $(call assert_boolean,CSS_SCMI_POST_PWR_DOWN))
+$(eval $(call add_define,CSS_SCMI_POST_PWR_DOWN))
+
+# Process CSS_SCMI_POST_PWR_ON flag
+# Queue the SCMI POWER_STATE_SET requests issued on the CPU_ON path instead of
+# waiting for the SCMI channel and for the SCP to respond to them.
+CSS_SCMI_POST_PWR_ON		?= 0
+$(eval $(call assert_boolean,CSS_SCMI_POST_PWR_ON))
+$(eval $(call add_define,CSS_SCMI_POST_PWR_ON))
+
+# Process CSS_SCMI_WFE_WAIT flag
+# Wait for the SCP to respond to SCMI commands in WFE, woken up by the event
+# stream of the generic timer, instead of busy-polling the channel status.
+CSS_SCMI_WFE_WAIT		?= 0
+$(eval $(call assert_boolean,CSS_SCMI_WFE_WAIT))
+$(eval $(call add_define,CSS_SCMI_WFE_WAIT))
+
+# Process CSS_SCMI_STATS flag
+# Collect per-CPU SCMI command count and latency statistics, read by the
+# Normal world with the SCMI_STATS SiP SMC.
+CSS_SCMI_STATS			?= 0
+$(eval $(call assert_boolean,CSS_SCMI_STATS))
+$(eval $(call add_define,CSS_SCMI_STATS))
+
+ifneq (${ARCH},aarch64)
+  ifeq (${CSS_SCMI_WFE_WAIT},1)
+    $(error "CSS_SCMI_WFE_WAIT is only supported on AArch64")
+  endif
+  ifeq (${CSS_SCMI_STATS},1)
+    $(error "CSS_SCMI_STATS is only supported on AArch64")
+  endif
+endif
+
 # Process CSS_NON_SECURE_UART flag
 # This undocumented build option is only to enable debug access to the UART
 # from non secure code, which is useful on some platforms.
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2022, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2023, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -117,6 +117,9 @@ void css_pwr_domain_on_finish_late(const psci_power_state_t *target_state)
 
 	/* Setup the CPU power down request interrupt for secondary core(s) */
 	css_setup_cpu_pwr_down_intr();
+
+	/* Let the SCP driver send requests queued behind this CPU's one */
+	css_scp_on_finish();
 }
 
 /*******************************************************************************
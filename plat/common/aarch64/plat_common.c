@@ -33,6 +33,10 @@
 #pragma weak plat_ea_handler = plat_default_ea_handler
 #endif
 
+#if PSCI_EARLY_CPU_INIT
+#pragma weak plat_core_pos_to_mpidr
+#endif
+
 void bl31_plat_runtime_setup(void)
 {
 	console_switch_state(CONSOLE_FLAG_RUNTIME);
@@ -69,6 +73,17 @@ int plat_sdei_validate_entry_point(uintptr_t ep, unsigned int client_mode)
 }
 #endif
 
+#if PSCI_EARLY_CPU_INIT
+/*
+ * Default function for platforms which cannot convert a core position into an
+ * MPIDR. No secondary cpu is then powered up early during cold boot.
+ */
+u_register_t plat_core_pos_to_mpidr(unsigned int core_pos)
+{
+	return INVALID_MPID;
+}
+#endif
+
 const char *get_el_str(unsigned int el)
 {
 	if (el == MODE_EL3) {
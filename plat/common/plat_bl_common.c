@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2018-2023, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -9,6 +9,7 @@
 #include <arch_helpers.h>
 #include <common/bl_common.h>
 #include <common/debug.h>
+#include <lib/bootmarker_capture.h>
 #include <lib/xlat_tables/xlat_tables_compat.h>
 #include <plat/common/platform.h>
 #include <services/arm_arch_svc.h>
@@ -123,6 +124,8 @@ void __init setup_page_tables(const mmap_region_t *bl_regions,
 		regions++;
 	}
 #endif
+	BOOT_PHASE_START(BOOT_PHASE_XLAT_INIT, BOOT_PHASE_NO_IMAGE);
+
 	/*
 	 * Map the Trusted SRAM with appropriate memory attributes.
 	 * Subsequent mappings will adjust the attributes for specific regions.
@@ -134,4 +137,6 @@ void __init setup_page_tables(const mmap_region_t *bl_regions,
 
 	/* Create the page tables to reflect the above mappings */
 	init_xlat_tables();
+
+	BOOT_PHASE_END(BOOT_PHASE_XLAT_INIT, BOOT_PHASE_NO_IMAGE);
 }
@@ -33,7 +33,7 @@
 PMF_DECLARE_CAPTURE_TIMESTAMP(psci_svc)
 PMF_DECLARE_GET_TIMESTAMP(psci_svc)
 PMF_REGISTER_SERVICE(psci_svc, PMF_PSCI_STAT_SVC_ID, PSCI_STAT_TOTAL_IDS,
-	PMF_STORE_ENABLE)
+	PMF_STORE_ENABLE | PMF_TRACE_ENABLE)
 
 /*
  * This function calculates the stats residency in microseconds,
@@ -1,6 +1,6 @@
 /*
  * Copyright (c) 2016, Linaro Limited
- * Copyright (c) 2019, ARM Limited. All rights reserved.
+ * Copyright (c) 2019-2023, ARM Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-2-Clause
  */
@@ -105,6 +105,7 @@ static void print_loc(const char *func, struct source_location *loc)
 {
 	ERROR("Undefined behavior at %s:%d col %d (%s)",
 		loc->file_name, loc->line, loc->column, func);
+	console_flush();
 }
 
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2022, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2023, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -12,6 +12,20 @@
 
 #define MAP_OFF(_map, _mapping) ((_map) - (_mapping)->map)
 
+/*
+ * Number of interrupt IDs covered by the interrupt to event lookup table. This
+ * spans SGIs, PPIs and SPIs; bound interrupts outside of this range are looked
+ * up with a linear search.
+ */
+#define SDEI_INTR_LOOKUP_SIZE	U(1020)
+
+/*
+ * Interrupt to event lookup table. Each entry holds 1 + the index of the map
+ * bound to the interrupt, in the private mapping for SGIs and PPIs and in the
+ * shared mapping for SPIs, or 0 if no map is bound to it.
+ */
+static uint8_t sdei_intr_lookup[SDEI_INTR_LOOKUP_SIZE];
+
 /*
  * Get SDEI entry with the given mapping: on success, returns pointer to SDEI
  * entry. On error, returns NULL.
@@ -51,6 +65,66 @@ sdei_entry_t *get_event_entry(sdei_ev_map_t *map)
 	}
 }
 
+/* Return the mapping that a map of the given type belongs to */
+static const sdei_mapping_t *sdei_intr_mapping(bool shared)
+{
+	return shared ? SDEI_SHARED_MAPPING() : SDEI_PRIVATE_MAPPING();
+}
+
+/*
+ * Record in the lookup table that the map is bound to its interrupt. Must be
+ * called with the map lock held, or during initialisation.
+ */
+void sdei_intr_lookup_bind(sdei_ev_map_t *map)
+{
+	const sdei_mapping_t *mapping;
+
+	if ((map->intr == SDEI_DYN_IRQ) ||
+			(map->intr >= SDEI_INTR_LOOKUP_SIZE))
+		return;
+
+	mapping = sdei_intr_mapping(is_event_shared(map));
+	sdei_intr_lookup[map->intr] = (uint8_t) (MAP_OFF(map, mapping) + 1);
+}
+
+/*
+ * Remove the map from the lookup table, before it gets unbound from its
+ * interrupt. Must be called with the map lock held.
+ */
+void sdei_intr_lookup_unbind(sdei_ev_map_t *map)
+{
+	const sdei_mapping_t *mapping;
+
+	if ((map->intr == SDEI_DYN_IRQ) ||
+			(map->intr >= SDEI_INTR_LOOKUP_SIZE))
+		return;
+
+	mapping = sdei_intr_mapping(is_event_shared(map));
+	if (sdei_intr_lookup[map->intr] == (MAP_OFF(map, mapping) + 1))
+		sdei_intr_lookup[map->intr] = 0U;
+}
+
+/*
+ * Populate the interrupt to event lookup table with the statically bound
+ * mappings and event 0.
+ */
+void sdei_intr_lookup_init(void)
+{
+	const sdei_mapping_t *mapping;
+	sdei_ev_map_t *map;
+	unsigned int i, j;
+
+	for_each_mapping_type(i, mapping) {
+		/* Map indices must fit the lookup table entries */
+		assert(mapping->num_maps < UINT8_MAX);
+
+		iterate_mapping(mapping, j, map) {
+			if (is_map_bound(map) || (map->ev_num == SDEI_EVENT_0))
+				sdei_intr_lookup_bind(map);
+		}
+	}
+}
+
 /*
  * Find event mapping for a given interrupt number: On success, returns pointer
  * to the event mapping. On error, returns NULL.
@@ -61,12 +135,27 @@ sdei_ev_map_t *find_event_map_by_intr(unsigned int intr_num, bool shared)
 	sdei_ev_map_t *map;
 	unsigned int i;
 
+	mapping = sdei_intr_mapping(shared);
+
+	/*
+	 * Bound interrupts are looked up in the direct-indexed table. The
+	 * looked up map is checked against the interrupt number, as the table
+	 * is not updated atomically with the binding.
+	 */
+	if ((intr_num != SDEI_DYN_IRQ) && (intr_num < SDEI_INTR_LOOKUP_SIZE)) {
+		i = sdei_intr_lookup[intr_num];
+		if ((i != 0U) && (i <= mapping->num_maps)) {
+			map = &mapping->map[i - 1U];
+			if (map->intr == intr_num)
+				return map;
+		}
+	}
+
 	/*
-	 * Look for a match in private and shared mappings, as requested. This
-	 * is a linear search. However, if the mappings are required to be
-	 * sorted, for large maps, we could consider binary search.
+	 * Fall back to a linear search in private and shared mappings, as
+	 * requested. This is used to look for free dynamic mappings, bound to
+	 * SDEI_DYN_IRQ, and for interrupts not covered by the table.
 	 */
-	mapping = shared ? SDEI_SHARED_MAPPING() : SDEI_PRIVATE_MAPPING();
 	iterate_mapping(mapping, i, map) {
 		if (map->intr == intr_num)
 			return map;
@@ -82,18 +171,25 @@ sdei_ev_map_t *find_event_map_by_intr(unsigned int intr_num, bool shared)
 sdei_ev_map_t *find_event_map(int ev_num)
 {
 	const sdei_mapping_t *mapping;
-	sdei_ev_map_t *map;
-	unsigned int i, j;
+	unsigned int i;
+	size_t low, high, mid;
 
 	/*
-	 * Iterate through mappings to find a match. This is a linear search.
-	 * However, if the mappings are required to be sorted, for large maps,
-	 * we could consider binary search.
+	 * Mappings are required to be sorted by event number, which is
+	 * verified at initialisation, so binary search each of them.
 	 */
 	for_each_mapping_type(i, mapping) {
-		iterate_mapping(mapping, j, map) {
-			if (map->ev_num == ev_num)
-				return map;
+		low = 0U;
+		high = mapping->num_maps;
+		while (low < high) {
+			mid = low + ((high - low) / 2U);
+			if (mapping->map[mid].ev_num == ev_num)
+				return &mapping->map[mid];
+
+			if (mapping->map[mid].ev_num < ev_num)
+				low = mid + 1U;
+			else
+				high = mid;
 		}
 	}
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2021, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2023, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -17,6 +17,10 @@
 #include <common/debug.h>
 #include <common/runtime_svc.h>
 #include <lib/cassert.h>
+#if ENABLE_RUNTIME_INSTRUMENTATION
+#include <lib/pmf/pmf.h>
+#include <lib/runtime_instr.h>
+#endif
 #include <services/sdei.h>
 
 #include "sdei_private.h"
@@ -30,6 +34,10 @@
 /* Per-CPU SDEI state access macro */
 #define sdei_get_this_pe_state()	(&cpu_state[plat_my_core_pos()])
 
+/* Bits of the client SCTLR and of HCR_EL2 the dispatch SPSR depends on */
+#define SDEI_SPSR_SCTLR_MASK	(SCTLR_SPAN_BIT | SCTLR_DSSBS_BIT)
+#define SDEI_SPSR_HCR_MASK	(HCR_TGE_BIT | HCR_E2H_BIT)
+
 /* Structure to store information about an outstanding dispatch */
 typedef struct sdei_dispatch_context {
 	sdei_ev_map_t *map;
@@ -46,9 +54,24 @@ typedef struct sdei_dispatch_context {
 #endif
 } sdei_dispatch_context_t;
 
+/*
+ * SPSR for dispatches to the client, computed for a given client EL and
+ * configuration of the client SCTLR and HCR_EL2. The bits taken from the
+ * interrupted PSTATE are left out, and selected by 'pstate_mask'.
+ */
+typedef struct sdei_spsr_cache {
+	u_register_t spsr;
+	u_register_t pstate_mask;
+	u_register_t sctlr;
+	u_register_t hcr;
+	unsigned int client_el;
+	bool valid;
+} sdei_spsr_cache_t;
+
 /* Per-CPU SDEI state data */
 typedef struct sdei_cpu_state {
 	sdei_dispatch_context_t dispatch_stack[MAX_EVENT_NESTING];
+	sdei_spsr_cache_t spsr_cache;
 	unsigned short stack_top; /* Empty ascending */
 	bool pe_masked;
 	bool pending_enables;
@@ -110,12 +133,14 @@ void sdei_pe_unmask(void)
 
 	state->pending_enables = false;
 	state->pe_masked = false;
+
+	/* Events may be dispatched from now on */
+	sdei_prepare_dispatch();
 }
 
 /* Push a dispatch context to the dispatch stack */
-static sdei_dispatch_context_t *push_dispatch(void)
+static sdei_dispatch_context_t *push_dispatch(sdei_cpu_state_t *state)
 {
-	sdei_cpu_state_t *state = sdei_get_this_pe_state();
 	sdei_dispatch_context_t *disp_ctx;
 
 	/* Cannot have more than max events */
@@ -155,8 +180,8 @@ static sdei_dispatch_context_t *get_outstanding_dispatch(void)
 	return &state->dispatch_stack[state->stack_top - 1U];
 }
 
-static sdei_dispatch_context_t *save_event_ctx(sdei_ev_map_t *map,
-		void *tgt_ctx)
+static sdei_dispatch_context_t *save_event_ctx(sdei_cpu_state_t *state,
+		sdei_ev_map_t *map, void *tgt_ctx)
 {
 	sdei_dispatch_context_t *disp_ctx;
 	const gp_regs_t *tgt_gpregs;
@@ -166,7 +191,7 @@ static sdei_dispatch_context_t *save_event_ctx(sdei_ev_map_t *map,
 	tgt_gpregs = get_gpregs_ctx(tgt_ctx);
 	tgt_el3 = get_el3state_ctx(tgt_ctx);
 
-	disp_ctx = push_dispatch();
+	disp_ctx = push_dispatch(state);
 	assert(disp_ctx != NULL);
 	disp_ctx->map = map;
 
@@ -234,30 +259,27 @@ static cpu_context_t *restore_and_resume_ns_context(void)
 	return ns_ctx;
 }
 
+static u_register_t sdei_client_sctlr(unsigned int client_el)
+{
+	if (client_el == MODE_EL2) {
+		return read_sctlr_el2();
+	}
+
+	return read_sctlr_el1();
+}
+
 /*
- * Prepare for ERET:
- * - Set the ELR to the registered handler address
- * - Set the SPSR register as described in the SDEI documentation and
- *   the AArch64.TakeException() pseudocode function in
- *   ARM DDI 0487F.c page J1-7635
+ * Compute the SPSR for dispatches to the client as described in the SDEI
+ * documentation and the AArch64.TakeException() pseudocode function in
+ * ARM DDI 0487F.c page J1-7635, except for the bits taken from the interrupted
+ * PSTATE.
  */
-
-static void sdei_set_elr_spsr(sdei_entry_t *se, sdei_dispatch_context_t *disp_ctx)
+static void sdei_compute_spsr(sdei_spsr_cache_t *cache, unsigned int client_el,
+		u_register_t client_el_sctlr, u_register_t hcr_el2)
 {
-	unsigned int client_el = sdei_client_el();
 	u_register_t sdei_spsr = SPSR_64(client_el, MODE_SP_ELX,
 					DISABLE_ALL_EXCEPTIONS);
-
-	u_register_t interrupted_pstate = disp_ctx->spsr_el3;
-
-	/* Check the SPAN bit in the client el SCTLR */
-	u_register_t client_el_sctlr;
-
-	if (client_el == MODE_EL2) {
-		client_el_sctlr = read_sctlr_el2();
-	} else {
-		client_el_sctlr = read_sctlr_el1();
-	}
+	u_register_t pstate_mask = 0U;
 
 	/*
 	 * Check whether to force the PAN bit or use the value in the
@@ -269,7 +291,6 @@ static void sdei_set_elr_spsr(sdei_entry_t *se, sdei_dispatch_context_t *disp_ct
 	 * bit in SCTLR_EL2 as we have already checked for the condition
 	 * HCR_EL2.E2H = 1 and HCR_EL2.TGE = 1
 	 */
-	u_register_t hcr_el2 = read_hcr();
 	bool el_is_in_host = (read_feat_vhe_id_field() != 0U) &&
 			     (hcr_el2 & HCR_TGE_BIT) &&
 			     (hcr_el2 & HCR_E2H_BIT);
@@ -280,7 +301,7 @@ static void sdei_set_elr_spsr(sdei_entry_t *se, sdei_dispatch_context_t *disp_ct
 	    ((client_el_sctlr & SCTLR_SPAN_BIT) == 0U)) {
 		sdei_spsr |=  SPSR_PAN_BIT;
 	} else {
-		sdei_spsr |= (interrupted_pstate & SPSR_PAN_BIT);
+		pstate_mask |= SPSR_PAN_BIT;
 	}
 
 	/* If SSBS is implemented, take the value from the client el SCTLR */
@@ -300,22 +321,66 @@ static void sdei_set_elr_spsr(sdei_entry_t *se, sdei_dispatch_context_t *disp_ct
 	}
 
 	/* Take the DIT field from the pstate of the interrupted el */
-	sdei_spsr |= (interrupted_pstate & SPSR_DIT_BIT);
+	pstate_mask |= SPSR_DIT_BIT;
+
+	cache->spsr = sdei_spsr;
+	cache->pstate_mask = pstate_mask;
+	cache->sctlr = client_el_sctlr;
+	cache->hcr = hcr_el2;
+	cache->client_el = client_el;
+	cache->valid = true;
+}
+
+/*
+ * Compute the SPSR for dispatches on this PE ahead of time. This is called
+ * when the client registers or enables an event, or unmasks the PE, so that
+ * the SPSR only has to be recomputed at dispatch time if the client has since
+ * changed its configuration.
+ */
+void sdei_prepare_dispatch(void)
+{
+	unsigned int client_el = sdei_client_el();
 
-	cm_set_elr_spsr_el3(NON_SECURE, (uintptr_t) se->ep, sdei_spsr);
+	sdei_compute_spsr(&sdei_get_this_pe_state()->spsr_cache, client_el,
+			  sdei_client_sctlr(client_el) & SDEI_SPSR_SCTLR_MASK,
+			  read_hcr() & SDEI_SPSR_HCR_MASK);
+}
+
+/*
+ * Prepare for ERET:
+ * - Set the ELR to the registered handler address
+ * - Set the SPSR register from the precomputed value, and the interrupted
+ *   PSTATE
+ */
+static void sdei_set_elr_spsr(sdei_cpu_state_t *state, sdei_entry_t *se,
+		sdei_dispatch_context_t *disp_ctx)
+{
+	sdei_spsr_cache_t *cache = &state->spsr_cache;
+	unsigned int client_el = sdei_client_el();
+	u_register_t client_el_sctlr = sdei_client_sctlr(client_el) &
+		SDEI_SPSR_SCTLR_MASK;
+	u_register_t hcr_el2 = read_hcr() & SDEI_SPSR_HCR_MASK;
+
+	if (!cache->valid || (cache->client_el != client_el) ||
+	    (cache->sctlr != client_el_sctlr) || (cache->hcr != hcr_el2)) {
+		sdei_compute_spsr(cache, client_el, client_el_sctlr, hcr_el2);
+	}
+
+	cm_set_elr_spsr_el3(NON_SECURE, (uintptr_t) se->ep, cache->spsr |
+			    (disp_ctx->spsr_el3 & cache->pstate_mask));
 }
 
 /*
  * Populate the Non-secure context so that the next ERET will dispatch to the
  * SDEI client.
  */
-static void setup_ns_dispatch(sdei_ev_map_t *map, sdei_entry_t *se,
-		cpu_context_t *ctx, jmp_buf *dispatch_jmp)
+static void setup_ns_dispatch(sdei_cpu_state_t *state, sdei_ev_map_t *map,
+		sdei_entry_t *se, cpu_context_t *ctx, jmp_buf *dispatch_jmp)
 {
 	sdei_dispatch_context_t *disp_ctx;
 
 	/* Push the event and context */
-	disp_ctx = save_event_ctx(map, ctx);
+	disp_ctx = save_event_ctx(state, map, ctx);
 
 	/*
 	 * Setup handler arguments:
@@ -331,7 +396,7 @@ static void setup_ns_dispatch(sdei_ev_map_t *map, sdei_entry_t *se,
 	SMC_SET_GP(ctx, CTX_GPREG_X3, disp_ctx->spsr_el3);
 
 	/* Setup the elr and spsr register to prepare for ERET */
-	sdei_set_elr_spsr(se, disp_ctx);
+	sdei_set_elr_spsr(state, se, disp_ctx);
 
 #if DYNAMIC_WORKAROUND_CVE_2018_3639
 	cve_2018_3639_t *tgt_cve_2018_3639;
@@ -346,6 +411,12 @@ static void setup_ns_dispatch(sdei_ev_map_t *map, sdei_entry_t *se,
 #endif
 
 	disp_ctx->dispatch_jmp = dispatch_jmp;
+
+#if ENABLE_RUNTIME_INSTRUMENTATION
+	PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
+	    RT_INSTR_EXIT_SDEI_DISPATCH,
+	    PMF_NO_CACHE_MAINT);
+#endif
 }
 
 /* Handle a triggered SDEI interrupt while events were masked on this PE */
@@ -417,6 +488,12 @@ int sdei_intr_handler(uint32_t intr_raw, uint32_t flags, void *handle,
 	jmp_buf dispatch_jmp;
 	const uint64_t mpidr = read_mpidr_el1();
 
+#if ENABLE_RUNTIME_INSTRUMENTATION
+	PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
+	    RT_INSTR_ENTER_SDEI_DISPATCH,
+	    PMF_NO_CACHE_MAINT);
+#endif
+
 	/*
 	 * To handle an event, the following conditions must be true:
 	 *
@@ -548,7 +625,7 @@ int sdei_intr_handler(uint32_t intr_raw, uint32_t flags, void *handle,
 	}
 
 	/* Synchronously dispatch event */
-	setup_ns_dispatch(map, se, ctx, &dispatch_jmp);
+	setup_ns_dispatch(state, map, se, ctx, &dispatch_jmp);
 	begin_sdei_synchronous_dispatch(&dispatch_jmp);
 
 	/*
@@ -598,6 +675,12 @@ int sdei_dispatch_event(int ev_num)
 	sdei_cpu_state_t *state;
 	jmp_buf dispatch_jmp;
 
+#if ENABLE_RUNTIME_INSTRUMENTATION
+	PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
+	    RT_INSTR_ENTER_SDEI_DISPATCH,
+	    PMF_NO_CACHE_MAINT);
+#endif
+
 	/* Can't dispatch if events are masked on this PE */
 	state = sdei_get_this_pe_state();
 	if (state->pe_masked)
@@ -648,7 +731,7 @@ int sdei_dispatch_event(int ev_num)
 	ehf_activate_priority(sdei_event_priority(map));
 
 	/* Dispatch event synchronously */
-	setup_ns_dispatch(map, se, ns_ctx, &dispatch_jmp);
+	setup_ns_dispatch(state, map, se, ns_ctx, &dispatch_jmp);
 	begin_sdei_synchronous_dispatch(&dispatch_jmp);
 
 	/*
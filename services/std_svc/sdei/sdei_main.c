@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2023, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -229,6 +229,7 @@ void sdei_init(void)
 	plat_sdei_setup();
 	sdei_class_init(SDEI_CRITICAL);
 	sdei_class_init(SDEI_NORMAL);
+	sdei_intr_lookup_init();
 
 	/* Register priority level handlers */
 	ehf_register_priority_handler(PLAT_SDEI_CRITICAL_PRI,
@@ -449,6 +450,10 @@ static int64_t sdei_event_register(int ev_num,
 	/* Populate event entries */
 	set_sdei_entry(se, ep, arg, (unsigned int) flags, mpidr);
 
+	/* Prepare the dispatch of private events on this PE */
+	if (is_event_private(map))
+		sdei_prepare_dispatch();
+
 	/* Increment register count */
 	map->reg_count++;
 
@@ -496,6 +501,10 @@ static int64_t sdei_event_enable(int ev_num)
 	if (is_map_bound(map) && (!before && after))
 		plat_ic_enable_interrupt(map->intr);
 
+	/* Prepare the dispatch of private events on this PE */
+	if (is_event_private(map))
+		sdei_prepare_dispatch();
+
 	ret = 0;
 
 finish:
@@ -764,6 +773,7 @@ static int sdei_interrupt_bind(unsigned int intr_num)
 		if (!is_map_bound(map)) {
 			map->intr = intr_num;
 			set_map_bound(map);
+			sdei_intr_lookup_bind(map);
 			retry = false;
 		}
 		sdei_map_unlock(map);
@@ -821,6 +831,7 @@ static int sdei_interrupt_release(int ev_num)
 		 * during unregister.
 		 */
 
+		sdei_intr_lookup_unbind(map);
 		map->intr = SDEI_DYN_IRQ;
 		clr_map_bound(map);
 	} else {
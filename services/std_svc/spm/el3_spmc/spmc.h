@@ -96,6 +96,12 @@ enum mailbox_state {
 
 	/* There is a message that has been populated in the mailbox. */
 	MAILBOX_STATE_FULL,
+
+	/*
+	 * The SPMC is populating the RX buffer without holding the mailbox
+	 * lock. The buffers cannot be released or unmapped in this state.
+	 */
+	MAILBOX_STATE_BUSY,
 };
 
 struct mailbox {
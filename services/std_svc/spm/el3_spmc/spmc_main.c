@@ -809,6 +809,12 @@ static uint64_t rxtx_unmap_handler(uint32_t smc_fid,
 					     FFA_ERROR_INVALID_PARAMETER);
 	}
 
+	/* Check the SPMC is not populating the RX buffer. */
+	if (mbox->state == MAILBOX_STATE_BUSY) {
+		spin_unlock(&mbox->lock);
+		return spmc_ffa_error_return(handle, FFA_ERROR_DENIED);
+	}
+
 	/* Unmap RX Buffer */
 	if (mmap_remove_dynamic_region((uintptr_t) mbox->rx_buffer,
 				       buf_size) != 0) {
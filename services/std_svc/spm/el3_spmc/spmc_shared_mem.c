@@ -22,14 +22,24 @@
  * struct spmc_shmem_obj - Shared memory object.
  * @desc_size:      Size of @desc.
  * @desc_filled:    Size of @desc already received.
+ * @alloc_size:     Size reserved for @desc in the backing store. This may be
+ *                  larger than @desc_size to allow the descriptor to be
+ *                  converted in place.
  * @in_use:         Number of clients that have called ffa_mem_retrieve_req
  *                  without a matching ffa_mem_relinquish call.
+ * @pin_count:      Number of callers currently accessing @desc without
+ *                  holding the global lock.
+ * @freed:          Object has been freed but could not be removed from the
+ *                  backing store yet as other objects are pinned.
  * @desc:           FF-A memory region descriptor passed in ffa_mem_share.
  */
 struct spmc_shmem_obj {
 	size_t desc_size;
 	size_t desc_filled;
+	size_t alloc_size;
 	size_t in_use;
+	unsigned int pin_count;
+	bool freed;
 	struct ffa_mtd desc;
 };
 
@@ -62,6 +72,9 @@ static size_t spmc_shmem_obj_size(size_t desc_size)
  * @state:      Global state.
  * @desc_size:  Size of struct ffa_memory_region_descriptor object that
  *              allocated object will hold.
+ * @extra_size: Additional space to reserve after the descriptor, used when
+ *              the descriptor will later be converted in place to a larger
+ *              format.
  *
  * Return: Pointer to newly allocated object, or %NULL if there not enough space
  *         left. The returned pointer is only valid while @state is locked, to
@@ -69,10 +82,12 @@ static size_t spmc_shmem_obj_size(size_t desc_size)
  *         called.
  */
 static struct spmc_shmem_obj *
-spmc_shmem_obj_alloc(struct spmc_shmem_obj_state *state, size_t desc_size)
+spmc_shmem_obj_alloc(struct spmc_shmem_obj_state *state, size_t desc_size,
+		     size_t extra_size)
 {
 	struct spmc_shmem_obj *obj;
 	size_t free = state->data_size - state->allocated;
+	size_t alloc_size;
 	size_t obj_size;
 
 	if (state->data == NULL) {
@@ -81,16 +96,17 @@ spmc_shmem_obj_alloc(struct spmc_shmem_obj_state *state, size_t desc_size)
 	}
 
 	/* Ensure that descriptor size is aligned */
-	if (!is_aligned(desc_size, 16)) {
+	if (!is_aligned(desc_size, 16) || !is_aligned(extra_size, 16)) {
 		WARN("%s(0x%zx) desc_size not 16-byte aligned\n",
 		     __func__, desc_size);
 		return NULL;
 	}
 
-	obj_size = spmc_shmem_obj_size(desc_size);
+	alloc_size = desc_size + extra_size;
+	obj_size = spmc_shmem_obj_size(alloc_size);
 
 	/* Ensure the obj size has not overflowed. */
-	if (obj_size < desc_size) {
+	if ((alloc_size < desc_size) || (obj_size < alloc_size)) {
 		WARN("%s(0x%zx) desc_size overflow\n",
 		     __func__, desc_size);
 		return NULL;
@@ -105,11 +121,46 @@ spmc_shmem_obj_alloc(struct spmc_shmem_obj_state *state, size_t desc_size)
 	obj->desc = (struct ffa_mtd) {0};
 	obj->desc_size = desc_size;
 	obj->desc_filled = 0;
+	obj->alloc_size = alloc_size;
 	obj->in_use = 0;
+	obj->pin_count = 0;
+	obj->freed = false;
 	state->allocated += obj_size;
 	return obj;
 }
 
+/**
+ * spmc_shmem_obj_compact - Remove freed objects from the backing store.
+ * @state:      Global state.
+ *
+ * Must only be called when no object is pinned. All pointers to struct
+ * spmc_shmem_obj objects should be considered invalid on return.
+ */
+static void spmc_shmem_obj_compact(struct spmc_shmem_obj_state *state)
+{
+	uint8_t *curr = state->data;
+	size_t live = 0U;
+
+	assert(state->pinned == 0U);
+
+	while (curr - state->data < state->allocated) {
+		struct spmc_shmem_obj *obj = (struct spmc_shmem_obj *)curr;
+		size_t obj_size = spmc_shmem_obj_size(obj->alloc_size);
+		bool freed = obj->freed;
+
+		if (!freed && (curr != state->data + live)) {
+			memmove(state->data + live, curr, obj_size);
+		}
+		if (!freed) {
+			live += obj_size;
+		}
+		curr += obj_size;
+	}
+
+	state->allocated = live;
+	state->deferred_free = 0U;
+}
+
 /**
  * spmc_shmem_obj_free - Free struct spmc_shmem_obj.
  * @state:      Global state.
@@ -120,23 +171,69 @@ spmc_shmem_obj_alloc(struct spmc_shmem_obj_state *state, size_t desc_size)
  * just @obj.
  *
  * The current implementation always compacts the remaining objects to simplify
- * the allocator and to avoid fragmentation.
+ * the allocator and to avoid fragmentation. If any object is currently pinned
+ * the compaction is deferred until the last pin is dropped, and @obj is only
+ * marked as freed so that lookups no longer return it.
  */
 
 static void spmc_shmem_obj_free(struct spmc_shmem_obj_state *state,
 				  struct spmc_shmem_obj *obj)
 {
-	size_t free_size = spmc_shmem_obj_size(obj->desc_size);
+	size_t free_size = spmc_shmem_obj_size(obj->alloc_size);
 	uint8_t *shift_dest = (uint8_t *)obj;
 	uint8_t *shift_src = shift_dest + free_size;
 	size_t shift_size = state->allocated - (shift_src - state->data);
 
+	assert(obj->pin_count == 0U);
+
+	if (state->pinned != 0U) {
+		obj->freed = true;
+		state->deferred_free++;
+		return;
+	}
+
 	if (shift_size != 0U) {
 		memmove(shift_dest, shift_src, shift_size);
 	}
 	state->allocated -= free_size;
 }
 
+/**
+ * spmc_shmem_obj_pin - Prevent an object from being moved or freed.
+ * @state:      Global state, must be locked.
+ * @obj:        Object to pin.
+ *
+ * Once pinned, the descriptor of a fully received object can be read after
+ * unlocking @state, until spmc_shmem_obj_unpin() is called.
+ */
+static void spmc_shmem_obj_pin(struct spmc_shmem_obj_state *state,
+			       struct spmc_shmem_obj *obj)
+{
+	obj->pin_count++;
+	state->pinned++;
+}
+
+/**
+ * spmc_shmem_obj_unpin - Drop a pin taken by spmc_shmem_obj_pin().
+ * @state:      Global state, must be locked.
+ * @obj:        Object to unpin.
+ *
+ * If this was the last pin, any deferred frees are completed, so on return all
+ * pointers to struct spmc_shmem_obj object should be considered invalid.
+ */
+static void spmc_shmem_obj_unpin(struct spmc_shmem_obj_state *state,
+				 struct spmc_shmem_obj *obj)
+{
+	assert((obj->pin_count != 0U) && (state->pinned != 0U));
+
+	obj->pin_count--;
+	state->pinned--;
+
+	if ((state->pinned == 0U) && (state->deferred_free != 0U)) {
+		spmc_shmem_obj_compact(state);
+	}
+}
+
 /**
  * spmc_shmem_obj_lookup - Lookup struct spmc_shmem_obj by handle.
  * @state:      Global state.
@@ -153,10 +250,10 @@ spmc_shmem_obj_lookup(struct spmc_shmem_obj_state *state, uint64_t handle)
 	while (curr - state->data < state->allocated) {
 		struct spmc_shmem_obj *obj = (struct spmc_shmem_obj *)curr;
 
-		if (obj->desc.handle == handle) {
+		if (!obj->freed && (obj->desc.handle == handle)) {
 			return obj;
 		}
-		curr += spmc_shmem_obj_size(obj->desc_size);
+		curr += spmc_shmem_obj_size(obj->alloc_size);
 	}
 	return NULL;
 }
@@ -175,12 +272,14 @@ spmc_shmem_obj_get_next(struct spmc_shmem_obj_state *state, size_t *offset)
 {
 	uint8_t *curr = state->data + *offset;
 
-	if (curr - state->data < state->allocated) {
+	while (curr - state->data < state->allocated) {
 		struct spmc_shmem_obj *obj = (struct spmc_shmem_obj *)curr;
 
-		*offset += spmc_shmem_obj_size(obj->desc_size);
-
-		return obj;
+		*offset += spmc_shmem_obj_size(obj->alloc_size);
+		if (!obj->freed) {
+			return obj;
+		}
+		curr = state->data + *offset;
 	}
 	return NULL;
 }
@@ -426,202 +525,148 @@ spmc_shm_get_v1_0_descriptor_size(struct ffa_mtd *orig, size_t desc_size)
 }
 
 /**
- * spmc_shm_convert_shmem_obj_from_v1_0 - Converts a given v1.0 memory object.
- * @out_obj:	The shared memory object to populate the converted descriptor.
- * @orig:	The shared memory object containing the v1.0 descriptor.
+ * spmc_shm_convert_shmem_obj_from_v1_0 - Converts a given v1.0 memory object
+ *                                        to the v1.1 format in place.
+ * @obj:	The shared memory object containing the v1.0 descriptor. It
+ *		must have been allocated with enough extra space to hold the
+ *		larger v1.1 descriptor.
  *
  * Return: true if the conversion is successful else false.
  */
 static bool
-spmc_shm_convert_shmem_obj_from_v1_0(struct spmc_shmem_obj *out_obj,
-				     struct spmc_shmem_obj *orig)
+spmc_shm_convert_shmem_obj_from_v1_0(struct spmc_shmem_obj *obj)
 {
-	struct ffa_mtd_v1_0 *mtd_orig = (struct ffa_mtd_v1_0 *) &orig->desc;
-	struct ffa_mtd *out = &out_obj->desc;
-	struct ffa_emad_v1_0 *emad_array_in;
+	struct ffa_mtd_v1_0 *mtd_orig = (struct ffa_mtd_v1_0 *) &obj->desc;
+	struct ffa_mtd_v1_0 hdr = *mtd_orig;
+	struct ffa_mtd *out = &obj->desc;
 	struct ffa_emad_v1_0 *emad_array_out;
 	struct ffa_comp_mrd *mrd_in;
-	struct ffa_comp_mrd *mrd_out;
 
+	size_t emad_array_size;
 	size_t mrd_in_offset;
 	size_t mrd_out_offset;
 	size_t mrd_size = 0;
 
-	/* Populate the new descriptor format from the v1.0 struct. */
-	out->sender_id = mtd_orig->sender_id;
-	out->memory_region_attributes = mtd_orig->memory_region_attributes;
-	out->flags = mtd_orig->flags;
-	out->handle = mtd_orig->handle;
-	out->tag = mtd_orig->tag;
-	out->emad_count = mtd_orig->emad_count;
-	out->emad_size = sizeof(struct ffa_emad_v1_0);
+	emad_array_size = (size_t)hdr.emad_count * sizeof(struct ffa_emad_v1_0);
+
+	/* Bound check for emad array. */
+	if ((offsetof(struct ffa_mtd_v1_0, emad) + emad_array_size) >
+	    obj->desc_size) {
+		VERBOSE("%s: Invalid mtd structure.\n", __func__);
+		return false;
+	}
 
 	/*
-	 * We will locate the emad descriptors directly after the ffa_mtd
-	 * struct. This will be 8-byte aligned.
+	 * The offset provided to the composite memory region descriptor should
+	 * be consistent across endpoint descriptors. Check it before the
+	 * conversion rewrites the offsets, so that spmc_shmem_check_obj() does
+	 * not see inconsistent offsets normalised.
 	 */
-	out->emad_offset = sizeof(struct ffa_mtd);
-
-	emad_array_in = mtd_orig->emad;
-	emad_array_out = (struct ffa_emad_v1_0 *)
-			 ((uint8_t *) out + out->emad_offset);
-
-	/* Copy across the emad structs. */
-	for (unsigned int i = 0U; i < out->emad_count; i++) {
-		/* Bound check for emad array. */
-		if (((uint8_t *)emad_array_in + sizeof(struct ffa_emad_v1_0)) >
-		    ((uint8_t *) mtd_orig + orig->desc_size)) {
-			VERBOSE("%s: Invalid mtd structure.\n", __func__);
+	for (unsigned int i = 1U; i < hdr.emad_count; i++) {
+		if (mtd_orig->emad[i].comp_mrd_offset !=
+		    mtd_orig->emad[0].comp_mrd_offset) {
+			ERROR("%s: mismatching offsets provided, %u != %u\n",
+			      __func__, mtd_orig->emad[i].comp_mrd_offset,
+			      mtd_orig->emad[0].comp_mrd_offset);
 			return false;
 		}
-		memcpy(&emad_array_out[i], &emad_array_in[i],
-		       sizeof(struct ffa_emad_v1_0));
 	}
 
-	/* Place the mrd descriptors after the end of the emad descriptors.*/
-	mrd_in_offset = emad_array_in->comp_mrd_offset;
-	mrd_out_offset = out->emad_offset + (out->emad_size * out->emad_count);
-	mrd_out = (struct ffa_comp_mrd *) ((uint8_t *) out + mrd_out_offset);
+	/*
+	 * Place the emad descriptors directly after the ffa_mtd struct, which
+	 * will be 8-byte aligned, and the mrd descriptors after the end of the
+	 * emad descriptors.
+	 */
+	mrd_in_offset = mtd_orig->emad[0].comp_mrd_offset;
+	mrd_out_offset = sizeof(struct ffa_mtd) + emad_array_size;
 
-	/* Add the size of the composite memory region descriptor. */
-	mrd_size += sizeof(struct ffa_comp_mrd);
+	/* Check the composite descriptor header is within the descriptor. */
+	if ((mrd_in_offset + sizeof(struct ffa_comp_mrd)) > obj->desc_size) {
+		ERROR("%s: Invalid mrd structure.\n", __func__);
+		return false;
+	}
 
 	/* Find the mrd descriptor. */
 	mrd_in = (struct ffa_comp_mrd *) ((uint8_t *) mtd_orig + mrd_in_offset);
 
+	/* Add the size of the composite memory region descriptor. */
+	mrd_size += sizeof(struct ffa_comp_mrd);
+
 	/* Add the size of the constituent memory region descriptors. */
 	mrd_size += mrd_in->address_range_count * sizeof(struct ffa_cons_mrd);
 
-	/*
-	 * Update the offset in the emads by the delta between the input and
-	 * output addresses.
-	 */
-	for (unsigned int i = 0U; i < out->emad_count; i++) {
-		emad_array_out[i].comp_mrd_offset =
-			emad_array_in[i].comp_mrd_offset +
-			(mrd_out_offset - mrd_in_offset);
-	}
-
 	/* Verify that we stay within bound of the memory descriptors. */
-	if ((uintptr_t)((uint8_t *) mrd_in + mrd_size) >
-	     (uintptr_t)((uint8_t *) mtd_orig + orig->desc_size) ||
-	    ((uintptr_t)((uint8_t *) mrd_out + mrd_size) >
-	     (uintptr_t)((uint8_t *) out + out_obj->desc_size))) {
+	if (((mrd_in_offset + mrd_size) > obj->desc_size) ||
+	    ((mrd_out_offset + mrd_size) > obj->alloc_size)) {
 		ERROR("%s: Invalid mrd structure.\n", __func__);
 		return false;
 	}
 
-	/* Copy the mrd descriptors directly. */
-	memcpy(mrd_out, mrd_in, mrd_size);
-
-	return true;
-}
+	/*
+	 * Move the descriptors to their new location, starting with the
+	 * trailing mrd descriptors. The destination of the mrd descriptors lies
+	 * entirely after the source emad array, and the header has been
+	 * copied to @hdr, so nothing is overwritten before it has been moved.
+	 */
+	memmove((uint8_t *) out + mrd_out_offset,
+		(uint8_t *) mtd_orig + mrd_in_offset, mrd_size);
+	memmove((uint8_t *) out + sizeof(struct ffa_mtd), mtd_orig->emad,
+		emad_array_size);
 
-/**
- * spmc_shm_convert_mtd_to_v1_0 - Converts a given v1.1 memory object to
- *                                v1.0 memory object.
- * @out_obj:    The shared memory object to populate the v1.0 descriptor.
- * @orig:       The shared memory object containing the v1.1 descriptor.
- *
- * Return: true if the conversion is successful else false.
- */
-static bool
-spmc_shm_convert_mtd_to_v1_0(struct spmc_shmem_obj *out_obj,
-			     struct spmc_shmem_obj *orig)
-{
-	struct ffa_mtd *mtd_orig = &orig->desc;
-	struct ffa_mtd_v1_0 *out = (struct ffa_mtd_v1_0 *) &out_obj->desc;
-	struct ffa_emad_v1_0 *emad_in;
-	struct ffa_emad_v1_0 *emad_array_in;
-	struct ffa_emad_v1_0 *emad_array_out;
-	struct ffa_comp_mrd *mrd_in;
-	struct ffa_comp_mrd *mrd_out;
+	/* Populate the new descriptor format from the v1.0 struct. */
+	*out = (struct ffa_mtd) {0};
+	out->sender_id = hdr.sender_id;
+	out->memory_region_attributes = hdr.memory_region_attributes;
+	out->flags = hdr.flags;
+	out->handle = hdr.handle;
+	out->tag = hdr.tag;
+	out->emad_count = hdr.emad_count;
+	out->emad_size = sizeof(struct ffa_emad_v1_0);
+	out->emad_offset = sizeof(struct ffa_mtd);
 
-	size_t mrd_in_offset;
-	size_t mrd_out_offset;
-	size_t emad_out_array_size;
-	size_t mrd_size = 0;
-	size_t orig_desc_size = orig->desc_size;
-
-	/* Populate the v1.0 descriptor format from the v1.1 struct. */
-	out->sender_id = mtd_orig->sender_id;
-	out->memory_region_attributes = mtd_orig->memory_region_attributes;
-	out->flags = mtd_orig->flags;
-	out->handle = mtd_orig->handle;
-	out->tag = mtd_orig->tag;
-	out->emad_count = mtd_orig->emad_count;
-
-	/* Determine the location of the emad array in both descriptors. */
-	emad_array_in = (struct ffa_emad_v1_0 *)
-			((uint8_t *) mtd_orig + mtd_orig->emad_offset);
-	emad_array_out = out->emad;
-
-	/* Copy across the emad structs. */
-	emad_in = emad_array_in;
+	/* Point the emads at the relocated composite descriptor. */
+	emad_array_out = (struct ffa_emad_v1_0 *)
+			 ((uint8_t *) out + out->emad_offset);
 	for (unsigned int i = 0U; i < out->emad_count; i++) {
-		/* Bound check for emad array. */
-		if (((uint8_t *)emad_in + sizeof(struct ffa_emad_v1_0)) >
-				((uint8_t *) mtd_orig + orig_desc_size)) {
-			VERBOSE("%s: Invalid mtd structure.\n", __func__);
-			return false;
-		}
-		memcpy(&emad_array_out[i], emad_in,
-		       sizeof(struct ffa_emad_v1_0));
-
-		emad_in +=  mtd_orig->emad_size;
+		emad_array_out[i].comp_mrd_offset = mrd_out_offset;
 	}
 
-	/* Place the mrd descriptors after the end of the emad descriptors. */
-	emad_out_array_size = sizeof(struct ffa_emad_v1_0) * out->emad_count;
-
-	mrd_out_offset =  (uint8_t *) out->emad - (uint8_t *) out +
-			  emad_out_array_size;
-
-	mrd_out = (struct ffa_comp_mrd *) ((uint8_t *) out + mrd_out_offset);
-
-	mrd_in_offset = mtd_orig->emad_offset +
-			(mtd_orig->emad_size * mtd_orig->emad_count);
+	obj->desc_size = mrd_out_offset + mrd_size;
+	obj->desc_filled = obj->desc_size;
 
-	/* Add the size of the composite memory region descriptor. */
-	mrd_size += sizeof(struct ffa_comp_mrd);
-
-	/* Find the mrd descriptor. */
-	mrd_in = (struct ffa_comp_mrd *) ((uint8_t *) mtd_orig + mrd_in_offset);
-
-	/* Add the size of the constituent memory region descriptors. */
-	mrd_size += mrd_in->address_range_count * sizeof(struct ffa_cons_mrd);
+	return true;
+}
 
-	/*
-	 * Update the offset in the emads by the delta between the input and
-	 * output addresses.
-	 */
-	emad_in = emad_array_in;
+/**
+ * spmc_shm_copy_window - Copy the part of a source chunk that falls within
+ *                        the window of the output descriptor being returned.
+ * @dst:	Buffer holding the window.
+ * @buf_size:	Size of the window.
+ * @offset:	Offset of the window within the output descriptor.
+ * @pos:	Offset of @src within the output descriptor.
+ * @src:	Source chunk.
+ * @len:	Size of @src.
+ */
+static void spmc_shm_copy_window(uint8_t *dst, size_t buf_size, size_t offset,
+				 size_t pos, const void *src, size_t len)
+{
+	size_t skip = 0;
 
-	for (unsigned int i = 0U; i < out->emad_count; i++) {
-		emad_array_out[i].comp_mrd_offset = emad_in->comp_mrd_offset +
-						    (mrd_out_offset -
-						     mrd_in_offset);
-		emad_in +=  mtd_orig->emad_size;
+	if ((pos + len <= offset) || (pos >= offset + buf_size)) {
+		return;
 	}
 
-	/* Verify that we stay within bound of the memory descriptors. */
-	if ((uintptr_t)((uint8_t *) mrd_in + mrd_size) >
-	     (uintptr_t)((uint8_t *) mtd_orig + orig->desc_size) ||
-	    ((uintptr_t)((uint8_t *) mrd_out + mrd_size) >
-	     (uintptr_t)((uint8_t *) out + out_obj->desc_size))) {
-		ERROR("%s: Invalid mrd structure.\n", __func__);
-		return false;
+	if (pos < offset) {
+		skip = offset - pos;
 	}
 
-	/* Copy the mrd descriptors directly. */
-	memcpy(mrd_out, mrd_in, mrd_size);
-
-	return true;
+	memcpy(dst + (pos + skip - offset), (const uint8_t *) src + skip,
+	       MIN(len - skip, offset + buf_size - (pos + skip)));
 }
 
 /**
- * spmc_populate_ffa_v1_0_descriptor - Converts a given v1.1 memory object to
- *                                     the v1.0 format and populates the
+ * spmc_populate_ffa_v1_0_descriptor - Serializes a given v1.1 memory object in
+ *                                     the v1.0 format directly into the
  *                                     provided buffer.
  * @dst:	    Buffer to populate v1.0 ffa_memory_region_descriptor.
  * @orig_obj:	    Object containing v1.1 ffa_memory_region_descriptor.
@@ -631,52 +676,96 @@ spmc_shm_convert_mtd_to_v1_0(struct spmc_shmem_obj *out_obj,
  * @out_desc_size:  Will be populated with the total size of the v1.0
  *                  descriptor.
  *
+ * Only the parts of the v1.0 descriptor that fall within the requested window
+ * are generated, no intermediate copy of the descriptor is made and @orig_obj
+ * is only read.
+ *
  * Return: 0 if conversion and population succeeded.
- * Note: This function invalidates the reference to @orig therefore
- * `spmc_shmem_obj_lookup` must be called if further usage is required.
  */
 static uint32_t
 spmc_populate_ffa_v1_0_descriptor(void *dst, struct spmc_shmem_obj *orig_obj,
 				 size_t buf_size, size_t offset,
 				 size_t *copy_size, size_t *v1_0_desc_size)
 {
-		struct spmc_shmem_obj *v1_0_obj;
+	struct ffa_mtd *mtd_orig = &orig_obj->desc;
+	struct ffa_mtd_v1_0 hdr = {0};
+	const uint8_t *emad_in;
+	size_t emad_array_size;
+	size_t mrd_in_offset;
+	size_t mrd_out_offset;
+	size_t mrd_size;
+	size_t pos;
 
-		/* Calculate the size that the v1.0 descriptor will require. */
-		*v1_0_desc_size = spmc_shm_get_v1_0_descriptor_size(
-					&orig_obj->desc, orig_obj->desc_size);
+	/* Calculate the size that the v1.0 descriptor will require. */
+	*v1_0_desc_size = spmc_shm_get_v1_0_descriptor_size(
+				mtd_orig, orig_obj->desc_size);
 
-		if (*v1_0_desc_size == 0) {
-			ERROR("%s: cannot determine size of descriptor.\n",
-			      __func__);
-			return FFA_ERROR_INVALID_PARAMETER;
-		}
+	if (*v1_0_desc_size == 0) {
+		ERROR("%s: cannot determine size of descriptor.\n",
+		      __func__);
+		return FFA_ERROR_INVALID_PARAMETER;
+	}
+
+	if (offset >= *v1_0_desc_size) {
+		WARN("%s: invalid offset 0x%zx >= 0x%zx\n", __func__,
+		     offset, *v1_0_desc_size);
+		return FFA_ERROR_INVALID_PARAMETER;
+	}
+
+	emad_in = (const uint8_t *) mtd_orig + mtd_orig->emad_offset;
+	emad_array_size = (size_t)mtd_orig->emad_count *
+			  sizeof(struct ffa_emad_v1_0);
+	mrd_in_offset = ((const struct ffa_emad_v1_0 *)emad_in)->comp_mrd_offset;
+	mrd_out_offset = sizeof(struct ffa_mtd_v1_0) + emad_array_size;
+	mrd_size = *v1_0_desc_size - mrd_out_offset;
+
+	/* Verify that we stay within bound of the memory descriptors. */
+	if ((mrd_in_offset + mrd_size) > orig_obj->desc_size) {
+		ERROR("%s: Invalid mrd structure.\n", __func__);
+		return FFA_ERROR_INVALID_PARAMETER;
+	}
+
+	/* Populate the v1.0 descriptor header from the v1.1 struct. */
+	hdr.sender_id = mtd_orig->sender_id;
+	hdr.memory_region_attributes = mtd_orig->memory_region_attributes;
+	hdr.flags = mtd_orig->flags;
+	hdr.handle = mtd_orig->handle;
+	hdr.tag = mtd_orig->tag;
+	hdr.emad_count = mtd_orig->emad_count;
 
-		/* Get a new obj to store the v1.0 descriptor. */
-		v1_0_obj = spmc_shmem_obj_alloc(&spmc_shmem_obj_state,
-						*v1_0_desc_size);
+	spmc_shm_copy_window(dst, buf_size, offset, 0, &hdr, sizeof(hdr));
 
-		if (!v1_0_obj) {
-			return FFA_ERROR_NO_MEMORY;
+	/*
+	 * Emit the emad structs, updating the composite descriptor offset to
+	 * its location in the v1.0 layout. Skip over the emads that fall
+	 * before the requested window.
+	 */
+	pos = sizeof(struct ffa_mtd_v1_0);
+	for (unsigned int i = 0U; i < mtd_orig->emad_count; i++) {
+		struct ffa_emad_v1_0 emad;
+
+		if (pos >= offset + buf_size) {
+			break;
 		}
 
-		/* Perform the conversion from v1.1 to v1.0. */
-		if (!spmc_shm_convert_mtd_to_v1_0(v1_0_obj, orig_obj)) {
-			spmc_shmem_obj_free(&spmc_shmem_obj_state, v1_0_obj);
-			return FFA_ERROR_INVALID_PARAMETER;
+		if (pos + sizeof(emad) > offset) {
+			memcpy(&emad, emad_in, sizeof(emad));
+			emad.comp_mrd_offset = mrd_out_offset;
+			spmc_shm_copy_window(dst, buf_size, offset, pos,
+					     &emad, sizeof(emad));
 		}
 
-		*copy_size = MIN(v1_0_obj->desc_size - offset, buf_size);
-		memcpy(dst, (uint8_t *) &v1_0_obj->desc + offset, *copy_size);
+		emad_in += mtd_orig->emad_size;
+		pos += sizeof(struct ffa_emad_v1_0);
+	}
 
-		/*
-		 * We're finished with the v1.0 descriptor for now so free it.
-		 * Note that this will invalidate any references to the v1.1
-		 * descriptor.
-		 */
-		spmc_shmem_obj_free(&spmc_shmem_obj_state, v1_0_obj);
+	/* Copy the mrd descriptors directly. */
+	spmc_shm_copy_window(dst, buf_size, offset, mrd_out_offset,
+			     (uint8_t *) mtd_orig + mrd_in_offset, mrd_size);
 
-		return 0;
+	*copy_size = MIN(*v1_0_desc_size - offset, buf_size);
+
+	return 0;
 }
 
 static int
@@ -1101,49 +1190,24 @@ static long spmc_ffa_fill_desc(struct mailbox *mbox,
 	 * the descriptor format to use the v1.1 structures.
 	 */
 	if (ffa_version == MAKE_FFA_VERSION(1, 0)) {
-		struct spmc_shmem_obj *v1_1_obj;
-		uint64_t mem_handle;
-
 		/* Calculate the size that the v1.1 descriptor will required. */
 		uint64_t v1_1_desc_size =
 		    spmc_shm_get_v1_1_descriptor_size((void *) &obj->desc,
 						      obj->desc_size);
 
-		if (v1_1_desc_size > UINT32_MAX) {
+		if (v1_1_desc_size > obj->alloc_size) {
 			ret = FFA_ERROR_NO_MEMORY;
 			goto err_arg;
 		}
 
-		/* Get a new obj to store the v1.1 descriptor. */
-		v1_1_obj =
-		    spmc_shmem_obj_alloc(&spmc_shmem_obj_state, (size_t)v1_1_desc_size);
-
-		if (!v1_1_obj) {
-			ret = FFA_ERROR_NO_MEMORY;
-			goto err_arg;
-		}
-
-		/* Perform the conversion from v1.0 to v1.1. */
-		v1_1_obj->desc_size = (uint32_t)v1_1_desc_size;
-		v1_1_obj->desc_filled = (uint32_t)v1_1_desc_size;
-		if (!spmc_shm_convert_shmem_obj_from_v1_0(v1_1_obj, obj)) {
-			ERROR("%s: Could not convert mtd!\n", __func__);
-			spmc_shmem_obj_free(&spmc_shmem_obj_state, v1_1_obj);
-			goto err_arg;
-		}
-
 		/*
-		 * We're finished with the v1.0 descriptor so free it
-		 * and continue our checks with the new v1.1 descriptor.
+		 * Perform the conversion from v1.0 to v1.1 in place, the object
+		 * was allocated with enough space for the larger header.
 		 */
-		mem_handle = obj->desc.handle;
-		spmc_shmem_obj_free(&spmc_shmem_obj_state, obj);
-		obj = spmc_shmem_obj_lookup(&spmc_shmem_obj_state, mem_handle);
-		if (obj == NULL) {
-			ERROR("%s: Failed to find converted descriptor.\n",
-			     __func__);
+		if (!spmc_shm_convert_shmem_obj_from_v1_0(obj)) {
+			ERROR("%s: Could not convert mtd!\n", __func__);
 			ret = FFA_ERROR_INVALID_PARAMETER;
-			return spmc_ffa_error_return(smc_handle, ret);
+			goto err_arg;
 		}
 	}
 
@@ -1196,6 +1260,7 @@ long spmc_ffa_mem_send(uint32_t smc_fid,
 	ffa_mtd_flag32_t mtd_flag;
 	uint32_t ffa_version = get_partition_ffa_version(secure_origin);
 	size_t min_desc_size;
+	size_t extra_size = 0U;
 
 	if (address != 0U || page_count != 0U) {
 		WARN("%s: custom memory region for message not supported.\n",
@@ -1238,8 +1303,18 @@ long spmc_ffa_mem_send(uint32_t smc_fid,
 					     FFA_ERROR_INVALID_PARAMETER);
 	}
 
+	/*
+	 * A v1.0 descriptor is converted in place to the larger v1.1 format
+	 * once it has been fully received, reserve the space for it now.
+	 */
+	if (ffa_version == MAKE_FFA_VERSION(1, 0)) {
+		extra_size = sizeof(struct ffa_mtd) -
+			     sizeof(struct ffa_mtd_v1_0);
+	}
+
 	spin_lock(&spmc_shmem_obj_state.lock);
-	obj = spmc_shmem_obj_alloc(&spmc_shmem_obj_state, total_length);
+	obj = spmc_shmem_obj_alloc(&spmc_shmem_obj_state, total_length,
+				   extra_size);
 	if (obj == NULL) {
 		ret = FFA_ERROR_NO_MEMORY;
 		goto err_unlock;
@@ -1460,6 +1535,14 @@ spmc_ffa_mem_retrieve_req(uint32_t smc_fid,
 		goto err_unlock_mailbox;
 	}
 
+	/*
+	 * Claim the RX buffer and release the mailbox lock, so that other
+	 * execution contexts of the partition are not held up while the
+	 * request is validated and the descriptor copied.
+	 */
+	mbox->state = MAILBOX_STATE_BUSY;
+	spin_unlock(&mbox->lock);
+
 	spin_lock(&spmc_shmem_obj_state.lock);
 
 	obj = spmc_shmem_obj_lookup(&spmc_shmem_obj_state, req->handle);
@@ -1475,32 +1558,41 @@ spmc_ffa_mem_retrieve_req(uint32_t smc_fid,
 		goto err_unlock_all;
 	}
 
+	/*
+	 * The descriptor of a fully received object is not modified any more.
+	 * Pin the object so that it can be validated and copied to the RX
+	 * buffer without holding the global lock, allowing retrieve requests
+	 * on other cores to proceed in parallel.
+	 */
+	spmc_shmem_obj_pin(&spmc_shmem_obj_state, obj);
+	spin_unlock(&spmc_shmem_obj_state.lock);
+
 	if (req->emad_count != 0U && req->sender_id != obj->desc.sender_id) {
 		WARN("%s: wrong sender id 0x%x != 0x%x\n",
 		     __func__, req->sender_id, obj->desc.sender_id);
 		ret = FFA_ERROR_INVALID_PARAMETER;
-		goto err_unlock_all;
+		goto err_unpin;
 	}
 
 	if (req->emad_count != 0U && req->tag != obj->desc.tag) {
 		WARN("%s: wrong tag 0x%lx != 0x%lx\n",
 		     __func__, req->tag, obj->desc.tag);
 		ret = FFA_ERROR_INVALID_PARAMETER;
-		goto err_unlock_all;
+		goto err_unpin;
 	}
 
 	if (req->emad_count != 0U && req->emad_count != obj->desc.emad_count) {
 		WARN("%s: mistmatch of endpoint counts %u != %u\n",
 		     __func__, req->emad_count, obj->desc.emad_count);
 		ret = FFA_ERROR_INVALID_PARAMETER;
-		goto err_unlock_all;
+		goto err_unpin;
 	}
 
 	/* Ensure the NS bit is set to 0 in the request. */
 	if ((req->memory_region_attributes & FFA_MEM_ATTR_NS_BIT) != 0U) {
 		WARN("%s: NS mem attributes flags MBZ.\n", __func__);
 		ret = FFA_ERROR_INVALID_PARAMETER;
-		goto err_unlock_all;
+		goto err_unpin;
 	}
 
 	if (req->flags != 0U) {
@@ -1513,7 +1605,7 @@ spmc_ffa_mem_retrieve_req(uint32_t smc_fid,
 			WARN("%s: wrong mem transaction flags %x != %x\n",
 			__func__, req->flags, obj->desc.flags);
 			ret = FFA_ERROR_INVALID_PARAMETER;
-			goto err_unlock_all;
+			goto err_unpin;
 		}
 
 		if (req->flags != FFA_MTD_FLAG_TYPE_SHARE_MEMORY &&
@@ -1524,7 +1616,7 @@ spmc_ffa_mem_retrieve_req(uint32_t smc_fid,
 			 */
 			WARN("%s: invalid flags 0x%x\n", __func__, req->flags);
 			ret = FFA_ERROR_INVALID_PARAMETER;
-			goto err_unlock_all;
+			goto err_unpin;
 		}
 	}
 
@@ -1533,7 +1625,7 @@ spmc_ffa_mem_retrieve_req(uint32_t smc_fid,
 		WARN("%s: Invalid endpoint ID (0x%x).\n",
 			__func__, sp_ctx->sp_id);
 		ret = FFA_ERROR_INVALID_PARAMETER;
-		goto err_unlock_all;
+		goto err_unpin;
 	}
 
 	/* Validate that the provided emad offset and structure is valid.*/
@@ -1548,7 +1640,7 @@ spmc_ffa_mem_retrieve_req(uint32_t smc_fid,
 					((uint8_t *) req + total_length)) {
 			WARN("Invalid emad access.\n");
 			ret = FFA_ERROR_INVALID_PARAMETER;
-			goto err_unlock_all;
+			goto err_unpin;
 		}
 	}
 
@@ -1584,16 +1676,10 @@ spmc_ffa_mem_retrieve_req(uint32_t smc_fid,
 			WARN("%s: invalid receiver id (0x%x).\n",
 			     __func__, emad->mapd.endpoint_id);
 			ret = FFA_ERROR_INVALID_PARAMETER;
-			goto err_unlock_all;
+			goto err_unpin;
 		}
 	}
 
-	mbox->state = MAILBOX_STATE_FULL;
-
-	if (req->emad_count != 0U) {
-		obj->in_use++;
-	}
-
 	/*
 	 * If the caller is v1.0 convert the descriptor, otherwise copy
 	 * directly.
@@ -1604,7 +1690,7 @@ spmc_ffa_mem_retrieve_req(uint32_t smc_fid,
 							&out_desc_size);
 		if (ret != 0U) {
 			ERROR("%s: Failed to process descriptor.\n", __func__);
-			goto err_unlock_all;
+			goto err_unpin;
 		}
 	} else {
 		copy_size = MIN(obj->desc_size, buf_size);
@@ -1616,14 +1702,28 @@ spmc_ffa_mem_retrieve_req(uint32_t smc_fid,
 	/* Set the NS bit in the response if applicable. */
 	spmc_ffa_mem_retrieve_set_ns_bit(resp, sp_ctx);
 
+	spin_lock(&spmc_shmem_obj_state.lock);
+	if (req->emad_count != 0U) {
+		obj->in_use++;
+	}
+	spmc_shmem_obj_unpin(&spmc_shmem_obj_state, obj);
 	spin_unlock(&spmc_shmem_obj_state.lock);
+
+	spin_lock(&mbox->lock);
+	mbox->state = MAILBOX_STATE_FULL;
 	spin_unlock(&mbox->lock);
 
 	SMC_RET8(handle, FFA_MEM_RETRIEVE_RESP, out_desc_size,
 		 copy_size, 0, 0, 0, 0, 0);
 
+err_unpin:
+	spin_lock(&spmc_shmem_obj_state.lock);
+	spmc_shmem_obj_unpin(&spmc_shmem_obj_state, obj);
 err_unlock_all:
 	spin_unlock(&spmc_shmem_obj_state.lock);
+	/* Give the RX buffer back. */
+	spin_lock(&mbox->lock);
+	mbox->state = MAILBOX_STATE_EMPTY;
 err_unlock_mailbox:
 	spin_unlock(&mbox->lock);
 	return spmc_ffa_error_return(handle, ret);
@@ -1688,6 +1788,13 @@ long spmc_ffa_mem_frag_rx(uint32_t smc_fid,
 		goto err_unlock_shmem;
 	}
 
+	if (obj->desc_filled != obj->desc_size) {
+		WARN("%s: incomplete object desc filled %zu < size %zu\n",
+		     __func__, obj->desc_filled, obj->desc_size);
+		ret = FFA_ERROR_INVALID_PARAMETER;
+		goto err_unlock_shmem;
+	}
+
 	if (fragment_offset >= obj->desc_size) {
 		WARN("%s: invalid fragment_offset 0x%x >= 0x%zx\n",
 		     __func__, fragment_offset, obj->desc_size);
@@ -1695,6 +1802,10 @@ long spmc_ffa_mem_frag_rx(uint32_t smc_fid,
 		goto err_unlock_shmem;
 	}
 
+	/* Copy to the RX buffer without holding the global lock. */
+	spmc_shmem_obj_pin(&spmc_shmem_obj_state, obj);
+	spin_unlock(&spmc_shmem_obj_state.lock);
+
 	spin_lock(&mbox->lock);
 
 	if (mbox->rxtx_page_count == 0U) {
@@ -1711,7 +1822,9 @@ long spmc_ffa_mem_frag_rx(uint32_t smc_fid,
 
 	buf_size = mbox->rxtx_page_count * FFA_PAGE_SIZE;
 
-	mbox->state = MAILBOX_STATE_FULL;
+	/* Claim the RX buffer and copy to it without holding the lock. */
+	mbox->state = MAILBOX_STATE_BUSY;
+	spin_unlock(&mbox->lock);
 
 	/*
 	 * If the caller is v1.0 convert the descriptor, otherwise copy
@@ -1727,6 +1840,8 @@ long spmc_ffa_mem_frag_rx(uint32_t smc_fid,
 							&out_desc_size);
 		if (ret != 0U) {
 			ERROR("%s: Failed to process descriptor.\n", __func__);
+			spin_lock(&mbox->lock);
+			mbox->state = MAILBOX_STATE_EMPTY;
 			goto err_unlock_all;
 		}
 	} else {
@@ -1738,7 +1853,12 @@ long spmc_ffa_mem_frag_rx(uint32_t smc_fid,
 		memcpy(mbox->rx_buffer, src + fragment_offset, copy_size);
 	}
 
+	spin_lock(&mbox->lock);
+	mbox->state = MAILBOX_STATE_FULL;
 	spin_unlock(&mbox->lock);
+
+	spin_lock(&spmc_shmem_obj_state.lock);
+	spmc_shmem_obj_unpin(&spmc_shmem_obj_state, obj);
 	spin_unlock(&spmc_shmem_obj_state.lock);
 
 	SMC_RET8(handle, FFA_MEM_FRAG_TX, handle_low, handle_high,
@@ -1746,6 +1866,8 @@ long spmc_ffa_mem_frag_rx(uint32_t smc_fid,
 
 err_unlock_all:
 	spin_unlock(&mbox->lock);
+	spin_lock(&spmc_shmem_obj_state.lock);
+	spmc_shmem_obj_unpin(&spmc_shmem_obj_state, obj);
 err_unlock_shmem:
 	spin_unlock(&spmc_shmem_obj_state.lock);
 	return spmc_ffa_error_return(handle, ret);
@@ -1905,7 +2027,7 @@ int spmc_ffa_mem_reclaim(uint32_t smc_fid,
 		ret = FFA_ERROR_INVALID_PARAMETER;
 		goto err_unlock;
 	}
-	if (obj->in_use != 0U) {
+	if ((obj->in_use != 0U) || (obj->pin_count != 0U)) {
 		ret = FFA_ERROR_DENIED;
 		goto err_unlock;
 	}
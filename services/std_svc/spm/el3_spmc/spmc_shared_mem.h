@@ -37,13 +37,21 @@ CASSERT(sizeof(struct ffa_mem_relinquish_descriptor) == 16,
  * @data_size:      The size allocated for the backing store.
  * @allocated:      Number of bytes allocated in @data.
  * @next_handle:    Handle used for next allocated object.
- * @lock:           Lock protecting all state in this file.
+ * @pinned:         Number of outstanding object pins. While non-zero, objects
+ *                  in @data are not moved and freed objects are only marked
+ *                  as such until the last pin is dropped.
+ * @deferred_free:  Number of freed objects still occupying space in @data.
+ * @lock:           Lock protecting the layout of @data and the bookkeeping
+ *                  fields of the objects it holds. It is not held while a
+ *                  pinned object's descriptor is being read.
  */
 struct spmc_shmem_obj_state {
 	uint8_t *data;
 	size_t data_size;
 	size_t allocated;
 	uint64_t next_handle;
+	unsigned int pinned;
+	unsigned int deferred_free;
 	spinlock_t lock;
 };
 
@@ -205,10 +205,51 @@ static int32_t spmd_init(void)
 	return 1;
 }
 
+#if (EL3_EXCEPTION_HANDLING == 0)
+/*******************************************************************************
+ * spmd_group0_intr_drain
+ * Delegate the handling of the pending Group0 interrupts to the platform
+ * handler, one after the other, until none is pending or SPMD_MAX_DRAINED_INTR
+ * of them have been handled.
+ ******************************************************************************/
+static void spmd_group0_intr_drain(void)
+{
+	uint32_t intid;
+	unsigned int count;
+
+	for (count = 0U; count < SPMD_MAX_DRAINED_INTR; count++) {
+		if (plat_ic_get_pending_interrupt_type() != INTR_TYPE_EL3) {
+			break;
+		}
+
+		intid = plat_ic_acknowledge_interrupt();
+
+		/*
+		 * The interrupt may have been deasserted, or preempted by one
+		 * of another type, since it was seen pending. Nothing was
+		 * acknowledged in that case, so there is nothing to end.
+		 */
+		if (plat_ic_get_interrupt_id(intid) == INTR_ID_UNAVAILABLE) {
+			break;
+		}
+
+		if (plat_spmd_handle_group0_interrupt(intid) < 0) {
+			ERROR("Group0 interrupt %u not handled\n", intid);
+			panic();
+		}
+
+		/* Deactivate the corresponding Group0 interrupt. */
+		plat_ic_end_of_interrupt(intid);
+	}
+}
+#endif
+
 /*******************************************************************************
  * spmd_secure_interrupt_handler
  * Enter the SPMC for further handling of the secure interrupt by the SPMC
- * itself or a Secure Partition.
+ * itself or a Secure Partition. Secure interrupts that are already pending when
+ * the SPMC completes the handling are conveyed to the SPMC straight away, so
+ * that the non-secure context is saved and restored only once for all of them.
  ******************************************************************************/
 static uint64_t spmd_secure_interrupt_handler(uint32_t id,
 					      uint32_t flags,
@@ -218,6 +259,7 @@ static uint64_t spmd_secure_interrupt_handler(uint32_t id,
 	spmd_spm_core_context_t *ctx = spmd_get_context();
 	gp_regs_t *gpregs = get_gpregs_ctx(&ctx->cpu_ctx);
 	unsigned int linear_id = plat_my_core_pos();
+	unsigned int count = 0U;
 	int64_t rc;
 
 	/* Sanity check the security state when the exception was generated */
@@ -232,25 +274,47 @@ static uint64_t spmd_secure_interrupt_handler(uint32_t id,
 	cm_el2_sysregs_context_save(NON_SECURE);
 #endif
 
-	/* Convey the event to the SPMC through the FFA_INTERRUPT interface. */
-	write_ctx_reg(gpregs, CTX_GPREG_X0, FFA_INTERRUPT);
-	write_ctx_reg(gpregs, CTX_GPREG_X1, 0);
-	write_ctx_reg(gpregs, CTX_GPREG_X2, 0);
-	write_ctx_reg(gpregs, CTX_GPREG_X3, 0);
-	write_ctx_reg(gpregs, CTX_GPREG_X4, 0);
-	write_ctx_reg(gpregs, CTX_GPREG_X5, 0);
-	write_ctx_reg(gpregs, CTX_GPREG_X6, 0);
-	write_ctx_reg(gpregs, CTX_GPREG_X7, 0);
+	do {
+		/*
+		 * Convey the event to the SPMC through the FFA_INTERRUPT
+		 * interface.
+		 */
+		write_ctx_reg(gpregs, CTX_GPREG_X0, FFA_INTERRUPT);
+		write_ctx_reg(gpregs, CTX_GPREG_X1, 0);
+		write_ctx_reg(gpregs, CTX_GPREG_X2, 0);
+		write_ctx_reg(gpregs, CTX_GPREG_X3, 0);
+		write_ctx_reg(gpregs, CTX_GPREG_X4, 0);
+		write_ctx_reg(gpregs, CTX_GPREG_X5, 0);
+		write_ctx_reg(gpregs, CTX_GPREG_X6, 0);
+		write_ctx_reg(gpregs, CTX_GPREG_X7, 0);
+
+		/* Mark current core as handling a secure interrupt. */
+		ctx->secure_interrupt_ongoing = true;
+
+		rc = spmd_spm_core_sync_entry(ctx);
+		if (rc != 0ULL) {
+			ERROR("%s failed (%" PRId64 ") on CPU%u\n", __func__, rc,
+			      linear_id);
+		}
 
-	/* Mark current core as handling a secure interrupt. */
-	ctx->secure_interrupt_ongoing = true;
+		ctx->secure_interrupt_ongoing = false;
 
-	rc = spmd_spm_core_sync_entry(ctx);
-	if (rc != 0ULL) {
-		ERROR("%s failed (%" PRId64 ") on CPU%u\n", __func__, rc, linear_id);
-	}
+#if (EL3_EXCEPTION_HANDLING == 0)
+		/*
+		 * Handle the Group0 interrupts that became pending meanwhile
+		 * rather than trapping again as soon as the normal world is
+		 * resumed.
+		 */
+		spmd_group0_intr_drain();
+#endif
+		count++;
 
-	ctx->secure_interrupt_ongoing = false;
+		/*
+		 * The normal world cannot mask secure priorities, so a pending
+		 * secure interrupt would preempt it right after the return.
+		 */
+	} while ((count < SPMD_MAX_DRAINED_INTR) &&
+		 (plat_ic_get_pending_interrupt_type() == INTR_TYPE_S_EL1));
 
 	cm_el1_sysregs_context_restore(NON_SECURE);
 #if SPMD_SPM_AT_SEL2
@@ -273,8 +337,6 @@ static uint64_t spmd_group0_interrupt_handler_nwd(uint32_t id,
 						  void *handle,
 						  void *cookie)
 {
-	uint32_t intid;
-
 	/* Sanity check the security state when the exception was generated. */
 	assert(get_interrupt_src_ss(flags) == NON_SECURE);
 
@@ -285,16 +347,21 @@ static uint64_t spmd_group0_interrupt_handler_nwd(uint32_t id,
 
 	assert(plat_ic_get_pending_interrupt_type() == INTR_TYPE_EL3);
 
-	intid = plat_ic_acknowledge_interrupt();
+	/*
+	 * Handle all the pending Group0 interrupts before returning to the
+	 * normal world.
+	 */
+	spmd_group0_intr_drain();
 
-	if (plat_spmd_handle_group0_interrupt(intid) < 0) {
-		ERROR("Group0 interrupt %u not handled\n", intid);
-		panic();
+	/*
+	 * If a secure interrupt is pending as well, convey it to the SPMC
+	 * now rather than resuming the normal world only to trap again.
+	 */
+	if (plat_ic_get_pending_interrupt_type() == INTR_TYPE_S_EL1) {
+		return spmd_secure_interrupt_handler(INTR_ID_UNAVAILABLE,
+						     flags, handle, cookie);
 	}
 
-	/* Deactivate the corresponding Group0 interrupt. */
-	plat_ic_end_of_interrupt(intid);
-
 	return 0U;
 }
 #endif
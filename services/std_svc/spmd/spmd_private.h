@@ -61,6 +61,12 @@ typedef struct spmd_spm_core_context {
 #define SPMD_LP_FFA_DIR_REQ_ONGOING		U(0x1)
 #define SPMD_LP_FFA_INFO_GET_REG_ONGOING	U(0x2)
 
+/*
+ * Maximum number of back to back secure (or Group0) interrupts handled in a
+ * single entry into EL3, before returning to the normal world.
+ */
+#define SPMD_MAX_DRAINED_INTR			U(8)
+
 /*
  * Reserve ID for NS physical FFA Endpoint.
  */
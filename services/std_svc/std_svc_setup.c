@@ -9,6 +9,7 @@
 
 #include <common/debug.h>
 #include <common/runtime_svc.h>
+#include <lib/bootmarker_capture.h>
 #include <lib/el3_runtime/cpu_data.h>
 #include <lib/pmf/pmf.h>
 #include <lib/psci/psci.h>
@@ -48,9 +49,11 @@ static int32_t std_svc_setup(void)
 	 * PSCI is one of the specifications implemented as a Standard Service.
 	 * The `psci_setup()` also does EL3 architectural setup.
 	 */
+	BOOT_PHASE_START(BOOT_PHASE_PSCI_SETUP, BOOT_PHASE_NO_IMAGE);
 	if (psci_setup((const psci_lib_args_t *)svc_arg) != PSCI_E_SUCCESS) {
 		ret = 1;
 	}
+	BOOT_PHASE_END(BOOT_PHASE_PSCI_SETUP, BOOT_PHASE_NO_IMAGE);
 
 #if SPM_MM
 	if (spm_mm_setup() != 0) {
@@ -0,0 +1,254 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2023, Arm Limited. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+"""
+Decoder for the binary log of BL31, enabled with ENABLE_BINARY_LOG=1.
+
+The INFO and VERBOSE messages of BL31 are recorded in per-CPU rings as the
+offset of their format string in the .tf_log_fmt section of the ELF file,
+followed by a time-stamp and the raw arguments. This script reconstructs the
+text of the messages from the ELF file and a dump of the `tf_log_bin_rings`
+array, and prints them in time-stamp order.
+
+Usage:
+    tf_log_decode.py --where bl31.elf
+    tf_log_decode.py bl31.elf rings.bin
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+INFO_MAGIC = 0x424C4654  # "TFLB"
+INFO_VERSION = 1
+INFO_FORMAT = "<6I"
+
+REC_MAGIC = 0xB1
+REC_NUM_FIXED_WORDS = 2
+
+RINGS_SYMBOL = "tf_log_bin_rings"
+
+SHT_SYMTAB = 2
+SHT_NOBITS = 8
+SHF_ALLOC = 0x2
+
+# Prefixes printed by the default plat_log_get_prefix()
+PREFIXES = {
+    10: "ERROR:   ",
+    20: "NOTICE:  ",
+    30: "WARNING: ",
+    40: "INFO:    ",
+    50: "VERBOSE: ",
+}
+
+# Conversions supported by the TF-A printf()
+CONV_RE = re.compile(r"%(0(\d*))?(z|l{0,2})([%idcspxXu])")
+
+
+def read_sections(image):
+    """Return the sections of an ELF64 little-endian image, by name."""
+    if image[:6] != b"\x7fELF\x02\x01":
+        sys.exit("Not an ELF64 little-endian file")
+
+    (shoff,) = struct.unpack_from("<Q", image, 0x28)
+    shentsize, shnum, shstrndx = struct.unpack_from("<3H", image, 0x3A)
+
+    headers = [struct.unpack_from("<2I4Q2I2Q", image, shoff + i * shentsize)
+               for i in range(shnum)]
+
+    def data(hdr):
+        if hdr[1] == SHT_NOBITS:
+            return b""
+        return image[hdr[4]:hdr[4] + hdr[5]]
+
+    names = data(headers[shstrndx])
+    sections = {}
+    for hdr in headers:
+        name = names[hdr[0]:names.index(b"\0", hdr[0])].decode()
+        sections[name] = {"type": hdr[1], "flags": hdr[2], "addr": hdr[3],
+                          "link": hdr[6], "data": data(hdr)}
+    return sections, [data(hdr) for hdr in headers]
+
+
+def find_symbol(sections, all_data, name):
+    symtab = sections.get(".symtab")
+    if symtab is None or symtab["type"] != SHT_SYMTAB:
+        return None
+
+    strtab = all_data[symtab["link"]]
+    for off in range(0, len(symtab["data"]), 24):
+        st_name, _, _, _, st_value, _ = struct.unpack_from(
+            "<IBBHQQ", symtab["data"], off)
+        if strtab[st_name:strtab.index(b"\0", st_name)].decode() == name:
+            return st_value
+    return None
+
+
+class TfLogElf:
+    """The parts of a BL31 ELF file needed to decode the binary log."""
+
+    def __init__(self, elf_file):
+        sections, all_data = read_sections(elf_file.read())
+
+        fmt = sections.get(".tf_log_fmt")
+        if fmt is None:
+            sys.exit("No .tf_log_fmt section, was BL31 built with "
+                     "ENABLE_BINARY_LOG=1?")
+        self.fmt = fmt["data"]
+
+        info = struct.unpack_from(INFO_FORMAT, self.fmt, 0)
+        (magic, version, self.ring_size, self.ring_words, self.num_rings,
+         self.max_args) = info
+        if (magic != INFO_MAGIC) or (version != INFO_VERSION):
+            sys.exit("Unsupported binary log version")
+
+        self.rings_addr = find_symbol(sections, all_data, RINGS_SYMBOL)
+
+        # Loaded sections, to resolve the strings passed as arguments
+        self.sections = [(sec["addr"], sec["data"])
+                         for sec in sections.values()
+                         if (sec["flags"] & SHF_ALLOC) != 0 and
+                         sec["type"] != SHT_NOBITS]
+
+    def fmt_string(self, fmt_id):
+        if fmt_id >= len(self.fmt):
+            return None
+        end = self.fmt.find(b"\0", fmt_id)
+        return self.fmt[fmt_id:end].decode("ascii", "replace")
+
+    def string_at(self, addr):
+        for base, data in self.sections:
+            if base <= addr < base + len(data):
+                end = data.find(b"\0", addr - base)
+                return data[addr - base:end].decode("ascii", "replace")
+        return "<0x%x>" % addr
+
+
+def format_message(elf, fmt, args):
+    """Render a message the way the TF-A printf() would have."""
+    args = list(args)
+
+    def convert(match):
+        pad, width, length, conv = match.groups()
+        if conv == "%":
+            return "%"
+        arg = args.pop(0) if args else 0
+        if length == "" and conv not in "ps":
+            arg &= 0xFFFFFFFF
+            if conv in "id" and arg & 0x80000000:
+                arg -= 1 << 32
+        elif conv in "id" and arg & (1 << 63):
+            arg -= 1 << 64
+
+        if conv == "s":
+            return elf.string_at(arg)
+        if conv == "c":
+            return chr(arg & 0xFF)
+        if conv in "id":
+            spec = "d"
+        elif conv == "u":
+            spec = "d"
+        elif conv == "p":
+            prefix = "0x" if arg != 0 else ""
+            width = max(int(width or 0) - len(prefix), 0)
+            return prefix + ("%0*x" % (width, arg) if pad else "%x" % arg)
+        else:
+            spec = conv
+
+        if pad is not None:
+            return "%0*{}".format(spec) % (int(width or 0), arg)
+        return ("%" + spec) % arg
+
+    return CONV_RE.sub(convert, fmt)
+
+
+def decode_ring(elf, cpu, data):
+    """Yield the (time-stamp, cpu, level, text) of the records of a ring."""
+    words_offset = elf.ring_size - (elf.ring_words * 8)
+    (head,) = struct.unpack_from("<Q", data, 0)
+    words = struct.unpack_from("<%dQ" % elf.ring_words, data, words_offset)
+
+    if head <= elf.ring_words:
+        stream = list(words[:head])
+    else:
+        start = head % elf.ring_words
+        stream = list(words[start:] + words[:start])
+
+    i = 0
+    while i + REC_NUM_FIXED_WORDS <= len(stream):
+        hdr = stream[i]
+        level = (hdr >> 48) & 0xFF
+        nargs = (hdr >> 40) & 0xFF
+        fmt = elf.fmt_string(hdr & 0xFFFFFFFF)
+
+        # Resynchronise on the next header after a partly overwritten record
+        if ((hdr >> 56) != REC_MAGIC or level not in PREFIXES or
+                nargs > elf.max_args or fmt is None):
+            i += 1
+            continue
+
+        end = i + REC_NUM_FIXED_WORDS + nargs
+        if end > len(stream):
+            break
+
+        yield (stream[i + 1], cpu, level,
+               format_message(elf, fmt,
+                              stream[i + REC_NUM_FIXED_WORDS:end]))
+        i = end
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Decode the binary log of BL31.")
+    parser.add_argument("elf", type=argparse.FileType("rb"),
+                        help="BL31 ELF file")
+    parser.add_argument("dump", nargs="?", type=argparse.FileType("rb"),
+                        help="dump of the %s array" % RINGS_SYMBOL)
+    parser.add_argument("--where", action="store_true",
+                        help="print the address and size of the memory "
+                             "to dump, and exit")
+    parser.add_argument("--freq", type=int, default=0,
+                        help="frequency of the system counter in Hz, to "
+                             "print the time-stamps in seconds")
+    args = parser.parse_args()
+
+    elf = TfLogElf(args.elf)
+    size = elf.ring_size * elf.num_rings
+
+    if args.where:
+        if elf.rings_addr is None:
+            sys.exit("No %s symbol in the ELF file" % RINGS_SYMBOL)
+        print("0x%x 0x%x" % (elf.rings_addr, size))
+        return
+
+    if args.dump is None:
+        parser.error("the dump of the rings is required")
+
+    data = args.dump.read()
+    if len(data) < size:
+        sys.exit("The dump is too small: 0x%x bytes, expected 0x%x" %
+                 (len(data), size))
+
+    records = []
+    for cpu in range(elf.num_rings):
+        ring = data[cpu * elf.ring_size:(cpu + 1) * elf.ring_size]
+        records.extend(decode_ring(elf, cpu, ring))
+
+    for ts, cpu, level, text in sorted(records):
+        if args.freq != 0:
+            stamp = "%.6f" % (ts / args.freq)
+        else:
+            stamp = "%d" % ts
+        sys.stdout.write("[%s] cpu%d %s%s" % (stamp, cpu, PREFIXES[level],
+                                              text))
+        if not text.endswith("\n"):
+            sys.stdout.write("\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,580 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2023, Arm Limited. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+"""
+Generator of the translation tables of BL31 and BL2, for XLAT_TABLES_PREBUILT=1.
+
+The image describes its translation context in the `tf_xlat_prebuilt`
+structure, and the regions it maps in the `xlat_prebuilt_mmap` structure
+defined by the platform, whose limits are resolved by the linker. This script
+maps these regions the way the translation tables library does at runtime, and
+writes the tables and the state of the context in the .data section of the ELF
+file, before the binary is extracted from it. At runtime, the library uses them
+instead of building the tables if the regions added to the context match.
+
+This must be kept in sync with lib/xlat_tables_v2/xlat_tables_core.c.
+
+Usage:
+    xlat_prebuilt.py bl31.elf
+"""
+
+import argparse
+import struct
+import sys
+
+INFO_SYMBOL = "tf_xlat_prebuilt"
+INFO_MAGIC = 0x584C4154  # "XLAT"
+INFO_VERSION = 1
+INFO_HEADER_FORMAT = "<14Q"
+
+FLAG_BTI = 1 << 0
+FLAG_RME = 1 << 1
+FLAG_DYNAMIC = 1 << 2
+
+# mmap_region_t and xlat_prebuilt_region_t
+REGION_FORMAT = "<3QI4xQ"
+REGION_SIZE = struct.calcsize(REGION_FORMAT)
+
+SHT_SYMTAB = 2
+SHT_NOBITS = 8
+SHF_ALLOC = 0x2
+
+EL1_EL0_REGIME = 1
+EL2_REGIME = 2
+EL3_REGIME = 3
+
+# Translation table format with the 4KB granule, see xlat_tables_defs.h
+PAGE_SIZE_SHIFT = 12
+PAGE_SIZE = 1 << PAGE_SIZE_SHIFT
+XLAT_TABLE_ENTRIES_SHIFT = 9
+XLAT_TABLE_ENTRIES = 1 << XLAT_TABLE_ENTRIES_SHIFT
+XLAT_TABLE_LEVEL_MAX = 3
+MIN_LVL_BLOCK_DESC = 1
+XLAT_CONT_HINT_ENTRIES = 16
+
+INVALID_DESC = 0x0
+BLOCK_DESC = 0x1
+TABLE_DESC = 0x3
+PAGE_DESC = 0x3
+DESC_MASK = 0x3
+TABLE_ADDR_MASK = 0x0000FFFFFFFFF000
+
+ACCESS_FLAG = 1 << 8
+NSH = 0x0 << 6
+OSH = 0x2 << 6
+ISH = 0x3 << 6
+AP_RO = 0x1 << 5
+AP_RW = 0x0 << 5
+AP_ACCESS_UNPRIVILEGED = 0x1 << 4
+AP_NO_ACCESS_UNPRIVILEGED = 0x0 << 4
+AP_ONE_VA_RANGE_RES1 = 0x1 << 4
+NS = 0x1 << 3
+EL3_S1_NSE = 0x1 << 9
+ATTR_IWBWA_OWBWA_NTR_INDEX = 0x0
+ATTR_DEVICE_INDEX = 0x1
+ATTR_NON_CACHEABLE_INDEX = 0x2
+
+XN = 1 << 2
+UXN = 1 << 2
+PXN = 1 << 1
+CONT_HINT = 1 << 0
+GP = 1 << 50
+
+# Memory attributes, see xlat_tables_v2.h
+MT_TYPE_MASK = 0x7
+MT_DEVICE = 0
+MT_NON_CACHEABLE = 1
+MT_MEMORY = 2
+MT_RW = 1 << 3
+MT_PAS_MASK = 0x3 << 4
+MT_NS = 1 << 4
+MT_ROOT = 2 << 4
+MT_REALM = 3 << 4
+MT_EXECUTE_NEVER = 1 << 6
+MT_USER = 1 << 7
+MT_SHAREABILITY_MASK = 0x3 << 8
+MT_SHAREABILITY_OSH = 2 << 8
+MT_SHAREABILITY_NSH = 3 << 8
+MT_CODE = MT_MEMORY
+MT_DYNAMIC = 1 << 31
+
+
+def lower_attrs(attrs):
+    return (attrs & 0xfff) << 2
+
+
+def upper_attrs(attrs):
+    return (attrs & 0x7) << 52
+
+
+def addr_shift(level):
+    return PAGE_SIZE_SHIFT + XLAT_TABLE_ENTRIES_SHIFT * (XLAT_TABLE_LEVEL_MAX -
+                                                        level)
+
+
+def block_size(level):
+    return 1 << addr_shift(level)
+
+
+class Elf:
+    """An ELF64 little-endian image, whose loaded sections can be patched."""
+
+    def __init__(self, path):
+        self.path = path
+        with open(path, "rb") as elf_file:
+            self.image = bytearray(elf_file.read())
+
+        if self.image[:6] != b"\x7fELF\x02\x01":
+            sys.exit("%s: not an ELF64 little-endian file" % path)
+
+        (shoff,) = struct.unpack_from("<Q", self.image, 0x28)
+        shentsize, shnum, _ = struct.unpack_from("<3H", self.image,
+                                                        0x3A)
+        self.sections = [
+            struct.unpack_from("<2I4Q2I2Q", self.image, shoff + i * shentsize)
+            for i in range(shnum)]
+
+    def section_data(self, hdr):
+        if hdr[1] == SHT_NOBITS:
+            return b""
+        return self.image[hdr[4]:hdr[4] + hdr[5]]
+
+    def find_symbol(self, name):
+        for hdr in self.sections:
+            if hdr[1] != SHT_SYMTAB:
+                continue
+            symtab = self.section_data(hdr)
+            strtab = self.section_data(self.sections[hdr[6]])
+            for off in range(0, len(symtab), 24):
+                st_name, _, _, _, st_value, _ = struct.unpack_from(
+                    "<IBBHQQ", symtab, off)
+                end = strtab.index(b"\0", st_name)
+                if strtab[st_name:end].decode() == name:
+                    return st_value
+        return None
+
+    def offset(self, addr, size):
+        """File offset of a range of addresses in a loaded section."""
+        for hdr in self.sections:
+            if ((hdr[2] & SHF_ALLOC) == 0) or (hdr[1] == SHT_NOBITS):
+                continue
+            if hdr[3] <= addr and (addr + size) <= (hdr[3] + hdr[5]):
+                return hdr[4] + addr - hdr[3]
+        sys.exit("%s: 0x%x is not in a loaded section" % (self.path, addr))
+
+    def read(self, fmt, addr):
+        off = self.offset(addr, struct.calcsize(fmt))
+        return struct.unpack_from(fmt, self.image, off)
+
+    def write(self, fmt, addr, *values):
+        off = self.offset(addr, struct.calcsize(fmt))
+        struct.pack_into(fmt, self.image, off, *values)
+
+    def save(self):
+        with open(self.path, "wb") as elf_file:
+            elf_file.write(self.image)
+
+
+class Region:
+    """A region of memory, as in mmap_region_t."""
+
+    def __init__(self, base_pa, base_va, size, attr, granularity):
+        self.base_pa = base_pa
+        self.base_va = base_va
+        self.size = size
+        self.attr = attr
+        self.granularity = granularity
+
+    @property
+    def end_pa(self):
+        return self.base_pa + self.size - 1
+
+    @property
+    def end_va(self):
+        return self.base_va + self.size - 1
+
+    def __str__(self):
+        return "VA:0x%x PA:0x%x size:0x%x attr:0x%x granularity:0x%x" % (
+            self.base_va, self.base_pa, self.size, self.attr,
+            self.granularity)
+
+
+class XlatContext:
+    """The translation context of the image, as in xlat_ctx_t."""
+
+    def __init__(self, elf, info_addr):
+        (_, version, self.xlat_regime, self.flags, self.pa_max_address,
+         self.va_max_address, self.base_level, self.base_table,
+         self.base_table_entries, self.tables_addr, self.tables_num,
+         self.mmap_num, self.manifest, _) = elf.read(INFO_HEADER_FORMAT,
+                                                     info_addr)
+
+        if version != INFO_VERSION:
+            sys.exit("%s: unsupported version %d of %s" % (elf.path, version,
+                                                           INFO_SYMBOL))
+        if self.xlat_regime not in (EL1_EL0_REGIME, EL2_REGIME, EL3_REGIME):
+            sys.exit("%s: invalid translation regime %d" % (
+                elf.path, self.xlat_regime))
+
+        self.dynamic = (self.flags & FLAG_DYNAMIC) != 0
+        self.mmap = []
+
+        self.tables = {self.base_table: [INVALID_DESC] *
+                       self.base_table_entries}
+        self.next_table = 0
+        self.mapped_regions = [0] * self.tables_num
+
+    def table_addr(self, index):
+        return self.tables_addr + index * XLAT_TABLE_ENTRIES * 8
+
+    def table_index(self, addr):
+        return (addr - self.tables_addr) // (XLAT_TABLE_ENTRIES * 8)
+
+    def add_region(self, region):
+        """Port of mmap_add_region_ctx()."""
+        if region.size == 0:
+            return
+
+        error = self.check_region(region)
+        if error is not None:
+            sys.exit("Can't map region %s: %s" % (region, error))
+
+        pos = 0
+        while (pos < len(self.mmap)) and \
+                (self.mmap[pos].end_va < region.end_va):
+            pos += 1
+        while (pos < len(self.mmap)) and \
+                (self.mmap[pos].end_va == region.end_va) and \
+                (self.mmap[pos].size < region.size):
+            pos += 1
+        self.mmap.insert(pos, region)
+
+    def check_region(self, region):
+        """Port of mmap_add_region_check()."""
+        if ((region.base_pa % PAGE_SIZE) != 0) or \
+                ((region.base_va % PAGE_SIZE) != 0) or \
+                ((region.size % PAGE_SIZE) != 0):
+            return "not page aligned"
+
+        if region.granularity not in (block_size(1), block_size(2),
+                                      block_size(3)):
+            return "invalid granularity"
+
+        if (region.end_va > self.va_max_address) or \
+                (region.end_pa > self.pa_max_address):
+            return "out of the address space"
+
+        if len(self.mmap) >= self.mmap_num:
+            return "too many regions, increase MAX_MMAP_REGIONS"
+
+        for other in self.mmap:
+            fully_overlapped_va = \
+                ((region.base_va >= other.base_va) and
+                 (region.end_va <= other.end_va)) or \
+                ((other.base_va >= region.base_va) and
+                 (other.end_va <= region.end_va))
+
+            if fully_overlapped_va:
+                if (other.base_va - other.base_pa) != \
+                        (region.base_va - region.base_pa):
+                    return "overlaps %s with another offset" % other
+                if (region.base_va == other.base_va) and \
+                        (region.size == other.size):
+                    return "same as %s" % other
+            else:
+                separated_pa = (region.end_pa < other.base_pa) or \
+                    (region.base_pa > other.end_pa)
+                separated_va = (region.end_va < other.base_va) or \
+                    (region.base_va > other.end_va)
+                if not separated_va or not separated_pa:
+                    return "partially overlaps %s" % other
+
+        return None
+
+    def get_empty_table(self):
+        """Port of xlat_table_get_empty()."""
+        if self.dynamic:
+            for index in range(self.tables_num):
+                if self.mapped_regions[index] == 0:
+                    break
+            else:
+                return None
+        else:
+            if self.next_table >= self.tables_num:
+                return None
+            index = self.next_table
+            self.next_table += 1
+
+        addr = self.table_addr(index)
+        self.tables[addr] = [INVALID_DESC] * XLAT_TABLE_ENTRIES
+        return addr
+
+    def desc(self, attr, addr_pa, level):
+        """Port of xlat_desc()."""
+        desc = addr_pa
+        desc |= PAGE_DESC if level == XLAT_TABLE_LEVEL_MAX else BLOCK_DESC
+        desc |= lower_attrs(ACCESS_FLAG)
+
+        # xlat_arch_get_pas()
+        pas = attr & MT_PAS_MASK
+        if ((self.flags & FLAG_RME) != 0) and (pas == MT_REALM):
+            desc |= lower_attrs(EL3_S1_NSE | NS)
+        elif ((self.flags & FLAG_RME) != 0) and (pas == MT_ROOT):
+            desc |= lower_attrs(EL3_S1_NSE)
+        elif pas == MT_NS:
+            desc |= lower_attrs(NS)
+
+        desc |= lower_attrs(AP_RW if (attr & MT_RW) != 0 else AP_RO)
+
+        if self.xlat_regime == EL1_EL0_REGIME:
+            if (attr & MT_USER) != 0:
+                desc |= lower_attrs(AP_ACCESS_UNPRIVILEGED)
+            else:
+                desc |= lower_attrs(AP_NO_ACCESS_UNPRIVILEGED)
+            xn_desc = upper_attrs(UXN) | upper_attrs(PXN)
+        else:
+            desc |= lower_attrs(AP_ONE_VA_RANGE_RES1)
+            xn_desc = upper_attrs(XN)
+
+        mem_type = attr & MT_TYPE_MASK
+        if mem_type == MT_DEVICE:
+            desc |= lower_attrs(ATTR_DEVICE_INDEX | OSH)
+            desc |= xn_desc
+        else:
+            if ((attr & MT_RW) != 0) or ((attr & MT_EXECUTE_NEVER) != 0):
+                desc |= xn_desc
+
+            shareability = attr & MT_SHAREABILITY_MASK
+            if mem_type == MT_MEMORY:
+                desc |= lower_attrs(ATTR_IWBWA_OWBWA_NTR_INDEX)
+                if shareability == MT_SHAREABILITY_NSH:
+                    desc |= lower_attrs(NSH)
+                elif shareability == MT_SHAREABILITY_OSH:
+                    desc |= lower_attrs(OSH)
+                else:
+                    desc |= lower_attrs(ISH)
+
+                # The image doesn't use the tables if BTI isn't present
+                if ((self.flags & FLAG_BTI) != 0) and \
+                        ((attr & (MT_TYPE_MASK | MT_RW |
+                                  MT_EXECUTE_NEVER)) == MT_CODE):
+                    desc |= GP
+            elif mem_type == MT_NON_CACHEABLE:
+                desc |= lower_attrs(ATTR_NON_CACHEABLE_INDEX | OSH)
+            else:
+                sys.exit("Invalid memory type in attributes 0x%x" % attr)
+
+        return desc
+
+    @staticmethod
+    def map_region_action(region, desc_type, dest_pa, entry_base_va, level):
+        """Port of xlat_tables_map_region_action()."""
+        entry_end_va = entry_base_va + block_size(level) - 1
+
+        if (region.base_va <= entry_base_va) and \
+                (region.end_va >= entry_end_va):
+            if level == 3:
+                return None if desc_type == PAGE_DESC else "write"
+            if desc_type == TABLE_DESC:
+                return "recurse"
+            if desc_type == INVALID_DESC:
+                if ((dest_pa & (block_size(level) - 1)) != 0) or \
+                        (level < MIN_LVL_BLOCK_DESC) or \
+                        (region.granularity < block_size(level)):
+                    return "create"
+                return "write"
+            return None
+
+        if (region.base_va <= entry_end_va) or \
+                (region.end_va >= entry_base_va):
+            return "create" if desc_type == INVALID_DESC else "recurse"
+
+        return None
+
+    def map_region(self, region, table_base_va, table_addr, table_entries,
+                   level):
+        """Port of xlat_tables_map_region()."""
+        table = self.tables[table_addr]
+
+        if region.base_va > table_base_va:
+            table_idx_va = region.base_va & ~(block_size(level) - 1)
+        else:
+            table_idx_va = table_base_va
+        table_idx = (table_idx_va - table_base_va) >> addr_shift(level)
+
+        if self.dynamic and (level > self.base_level):
+            self.mapped_regions[self.table_index(table_addr)] += 1
+
+        while table_idx < table_entries:
+            desc = table[table_idx]
+            table_idx_pa = region.base_pa + table_idx_va - region.base_va
+            entry_end_va = table_idx_va + block_size(level) - 1
+
+            action = self.map_region_action(region, desc & DESC_MASK,
+                                            table_idx_pa, table_idx_va, level)
+
+            if action == "write":
+                table[table_idx] = self.desc(region.attr, table_idx_pa, level)
+            elif action in ("create", "recurse"):
+                if action == "create":
+                    subtable = self.get_empty_table()
+                    if subtable is None:
+                        return table_idx_va
+                    table[table_idx] = TABLE_DESC | subtable
+                else:
+                    subtable = desc & TABLE_ADDR_MASK
+
+                end_va = self.map_region(region, table_idx_va, subtable,
+                                         XLAT_TABLE_ENTRIES, level + 1)
+                if end_va != entry_end_va:
+                    return end_va
+
+            table_idx += 1
+            table_idx_va += block_size(level)
+
+            if region.end_va <= table_idx_va:
+                break
+
+        return table_idx_va - 1
+
+    def range_is_static(self, base_va, size):
+        """Port of xlat_range_is_static()."""
+        if not self.dynamic:
+            return True
+
+        end_va = base_va + size - 1
+        return any((base_va >= mm.base_va) and (end_va <= mm.end_va)
+                   for mm in self.mmap if (mm.attr & MT_DYNAMIC) == 0)
+
+    def set_cont_hint(self, table_addr, table_entries, table_base_va, level):
+        """Port of xlat_tables_set_cont_hint()."""
+        table = self.tables[table_addr]
+        size = block_size(level)
+        group_size = size * XLAT_CONT_HINT_ENTRIES
+        leaf_type = PAGE_DESC if level == XLAT_TABLE_LEVEL_MAX else BLOCK_DESC
+
+        if level < XLAT_TABLE_LEVEL_MAX:
+            for idx in range(table_entries):
+                if (table[idx] & DESC_MASK) == TABLE_DESC:
+                    self.set_cont_hint(table[idx] & TABLE_ADDR_MASK,
+                                       XLAT_TABLE_ENTRIES,
+                                       table_base_va + idx * size, level + 1)
+
+        if level < MIN_LVL_BLOCK_DESC:
+            return
+
+        for idx in range(0, table_entries - XLAT_CONT_HINT_ENTRIES + 1,
+                         XLAT_CONT_HINT_ENTRIES):
+            first = table[idx]
+            if (first & DESC_MASK) != leaf_type:
+                continue
+            if ((first & TABLE_ADDR_MASK) & (group_size - 1)) != 0:
+                continue
+            if any(table[idx + j] != first + j * size
+                   for j in range(1, XLAT_CONT_HINT_ENTRIES)):
+                continue
+            if not self.range_is_static(table_base_va + idx * size,
+                                        group_size):
+                continue
+            for j in range(XLAT_CONT_HINT_ENTRIES):
+                table[idx + j] |= upper_attrs(CONT_HINT)
+
+    def init(self):
+        """Port of init_xlat_tables_ctx()."""
+        for region in self.mmap:
+            end_va = self.map_region(region, 0, self.base_table,
+                                     self.base_table_entries,
+                                     self.base_level)
+            if end_va != region.end_va:
+                sys.exit("Not enough translation tables to map region %s, "
+                         "increase MAX_XLAT_TABLES" % region)
+
+        self.set_cont_hint(self.base_table, self.base_table_entries, 0,
+                           self.base_level)
+
+
+def read_regions(elf, addr, bl_regions):
+    """Read an array of regions terminated by a null granularity."""
+    regions = []
+    while addr != 0:
+        base_pa, base_va, size_or_end, attr, granularity = elf.read(
+            REGION_FORMAT, addr)
+        if granularity == 0:
+            break
+        if bl_regions:
+            # The end address is exclusive and rounded up to a page boundary
+            end_va = (size_or_end + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1)
+            size_or_end = end_va - base_va
+        regions.append(Region(base_pa, base_va, size_or_end, attr,
+                              granularity))
+        addr += REGION_SIZE
+    return regions
+
+
+def write_context(elf, info_addr, ctx):
+    for addr, table in ctx.tables.items():
+        elf.write("<%dQ" % len(table), addr, *table)
+
+    addr = info_addr + struct.calcsize(INFO_HEADER_FORMAT)
+    elf.write("<%dQ" % ctx.tables_num, addr, *ctx.mapped_regions)
+    addr += ctx.tables_num * 8
+
+    for index in range(ctx.mmap_num + 1):
+        if index < len(ctx.mmap):
+            mm = ctx.mmap[index]
+            values = (mm.base_pa, mm.base_va, mm.size, mm.attr,
+                      mm.granularity)
+        else:
+            values = (0, 0, 0, 0, 0)
+        elf.write(REGION_FORMAT, addr + index * REGION_SIZE, *values)
+
+    # next_table is the last field of the header, magic the first one
+    elf.write("<Q", info_addr + struct.calcsize(INFO_HEADER_FORMAT) - 8,
+              ctx.next_table)
+    elf.write("<Q", info_addr, INFO_MAGIC)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Generate the translation tables of a BL image built "
+                    "with XLAT_TABLES_PREBUILT=1")
+    parser.add_argument("elf", help="ELF file of the image, updated in place")
+    parser.add_argument("-v", "--verbose", action="store_true",
+                        help="print the regions and the number of tables")
+    args = parser.parse_args()
+
+    elf = Elf(args.elf)
+
+    info_addr = elf.find_symbol(INFO_SYMBOL)
+    if info_addr is None:
+        sys.exit("%s: no %s symbol, was it built with XLAT_TABLES_PREBUILT=1?"
+                 % (args.elf, INFO_SYMBOL))
+
+    ctx = XlatContext(elf, info_addr)
+    if ctx.manifest == 0:
+        sys.exit("%s: the platform doesn't define xlat_prebuilt_mmap"
+                 % args.elf)
+
+    bl_regions_addr, plat_regions_addr = elf.read("<2Q", ctx.manifest)
+    for region in read_regions(elf, bl_regions_addr, True):
+        ctx.add_region(region)
+    for region in read_regions(elf, plat_regions_addr, False):
+        ctx.add_region(region)
+
+    ctx.init()
+    write_context(elf, info_addr, ctx)
+    elf.save()
+
+    if args.verbose:
+        for region in ctx.mmap:
+            print(region)
+        print("%d translation tables used out of %d" % (
+            len(ctx.tables) - 1, ctx.tables_num))
+
+
+if __name__ == "__main__":
+    main()